@@ -0,0 +1,262 @@
+/********************************************
+File Name: 			batch.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Class:
+	 batch_admitter - Decides a whole set of pending requests in one pass and grants a
+	                  maximal subset of them that keeps the state safe.
+
+Procedures: Members of the batch_admitter class.
+
+batch_admitter(state* s, int n, int m, const vector<int>& order)
+    - Set up to admit requests against s, with the processes in order considered by the
+      safety checks.
+
+vector<int> admit_all(const vector<int>& procs, const matrix& amounts)
+    - Decide the requests amounts.row(i) by procs[i] in turn, granted ones are applied to s.
+      Returns event_grant, event_deny or event_error for every request.
+
+int admit(int p, const int* r)
+    - Decide one request and apply it to s if it is granted.
+********************************************/
+
+#ifndef batch_h
+#define batch_h
+
+#include <vector>
+#include <algorithm>
+
+#include "header.h"
+
+using namespace std;
+
+/********************************************
+Class Name: 		    batch_admitter
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Decides pending requests one after another while sharing work between them.
+
+        A safe sequence q_0 ... q_n-1 of the state is kept, with slack_k = avail_k - need
+        of q_k, where avail_k is what is available just before q_k runs. prefix[k] is the
+        least slack before position k (prefix[0] is the available vector). If process p at
+        position t asks for r and r <= prefix[t], granting it leaves the same sequence
+        safe: every process before p sees r less available but had at least r to spare,
+        p's need shrinks by r along with what is available, and once p gives back its
+        allocation everyone after it sees the same as before. The test itself costs O(m);
+        keeping the sequence up to date after a grant costs O(t m) to take r off the slack
+        before p and O(n m) to rebuild prefix, against the O(n^2 m) of a full check.
+
+        Only when it fails is a full check run, on the state with the request applied in
+        place, and the request rolled back if it is unsafe. A granted request only takes
+        resources away, so a request that is denied can't be granted later in the same
+        batch and one pass gives a maximal set of granted requests.
+********************************************/
+class batch_admitter
+{
+private:
+  //the state requests are admitted against
+  state* s;
+  //number of processes and resources
+  int n, m;
+  //the processes considered by the safety checks
+  vector<int> order;
+  //a safe sequence of the state, empty if the state is unsafe
+  vector<int> sequence;
+  //the sequence found by the last full check
+  vector<int> candidate;
+  //position of every process in sequence
+  vector<int> position;
+  //slack of every position, row k is avail_k - need of sequence[k]
+  matrix slack;
+  //least slack before every position, row 0 is the available vector
+  matrix prefix;
+  //checker kept between full checks so its buffers are reused
+  adaptive_checker checker;
+
+  //Work out prefix from slack and the available vector.
+  void build_prefix()
+  {
+    int* p0 = prefix.mutable_row(0);
+    for(int j = 0; j < m; j++)
+    {
+      p0[j] = s->available[j];
+    }
+    for(int k = 0; k < (int)sequence.size(); k++)
+    {
+      row_view pk = prefix.row(k);
+      row_view sk = slack.row(k);
+      int* next = prefix.mutable_row(k + 1);
+      for(int j = 0; j < m; j++)
+      {
+        next[j] = min(pk[j], sk[j]);
+      }
+    }
+  }
+
+  //Move r from the available vector to process p, sign = -1 gives it back.
+  void apply(int p, const int* r, int sign)
+  {
+    int* allocation = s->allocation.mutable_row(p);
+    int* need = s->need.mutable_row(p);
+    for(int j = 0; j < m; j++)
+    {
+      allocation[j] += sign * r[j];
+      need[j] -= sign * r[j];
+      s->available[j] -= sign * r[j];
+    }
+  }
+
+  bool rebuild();
+
+public:
+  batch_admitter(state* st, int procs, int res, const vector<int>& ord);
+
+  bool is_safe() const { return sequence.size() == order.size(); }
+
+  int admit(int p, const int* r);
+
+  vector<int> admit_all(const vector<int>& procs, const matrix& amounts);
+};
+
+/********************************************
+Procedure Name: batch_admitter()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - st = the state requests are admitted against.
+  - procs & res = number of processes and resources.
+  - ord = the processes considered by the safety checks.
+
+Description:
+	The constructor for the batch_admitter class. Finds a safe sequence of the state.
+********************************************/
+batch_admitter::batch_admitter(state* st, int procs, int res, const vector<int>& ord)
+  : s(st), n(procs), m(res), order(ord), position(procs, -1),
+    slack(ord.size(), res), prefix(ord.size() + 1, res)
+{
+  //Mark the processes considered, rebuild() gives them their real positions.
+  for(int k = 0; k < (int)order.size(); k++)
+  {
+    position[order[k]] = k;
+  }
+  rebuild();
+}
+
+/********************************************
+Procedure Name: rebuild()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	None.
+
+Description:
+	Run a full safety check and, if the state is safe, keep the safe sequence found along
+  with the slack of every position. Returns false and keeps the old sequence if the
+  state is unsafe.
+********************************************/
+bool batch_admitter::rebuild()
+{
+  candidate.clear();
+  checker.start(s->need, s->allocation, s->available, order, m);
+  int p;
+  while((p = checker.next()) != -1)
+  {
+    candidate.push_back(p);
+  }
+  if(checker.remaining() > 0)
+    return false;
+  sequence.swap(candidate);
+
+  //Walk the sequence again to find what is available before every step.
+  vector<int> avail = s->available;
+  for(int k = 0; k < (int)sequence.size(); k++)
+  {
+    int q = sequence[k];
+    position[q] = k;
+    row_view need = s->need.row(q);
+    row_view allocation = s->allocation.row(q);
+    int* sk = slack.mutable_row(k);
+    for(int j = 0; j < m; j++)
+    {
+      sk[j] = avail[j] - need[j];
+      avail[j] += allocation[j];
+    }
+  }
+  build_prefix();
+  return true;
+}
+
+/********************************************
+Procedure Name: admit()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process asking.
+  - r = the m units it asks for.
+
+Description:
+	Decide one request. Tries the O(m) what-if against the kept safe sequence first and
+  only runs a full check if that fails. A granted request is applied to the state, and a
+  grant on the fast path updates the slack and prefix in O(n m).
+********************************************/
+int batch_admitter::admit(int p, const int* r)
+{
+  //A request over the claim is an error, one over what is available has to wait.
+  if(p < 0 || p >= n || position[p] < 0 || !row_le(r, s->need.row(p).data, m))
+    return event_error;
+  if(!is_safe() || !row_le(r, s->available.data(), m))
+    return event_deny;
+
+  int t = position[p];
+  if(row_le(r, prefix.row(t).data, m))
+  {
+    //The same sequence stays safe, everyone before p has r less to spare.
+    apply(p, r, 1);
+    for(int k = 0; k < t; k++)
+    {
+      int* sk = slack.mutable_row(k);
+      for(int j = 0; j < m; j++)
+      {
+        sk[j] -= r[j];
+      }
+    }
+    build_prefix();
+    return event_grant;
+  }
+
+  //Try the request for real and look for another safe sequence.
+  apply(p, r, 1);
+  if(rebuild())
+    return event_grant;
+  apply(p, r, -1);
+  return event_deny;
+}
+
+/********************************************
+Procedure Name: admit_all()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - procs = the processes asking, in the order their requests are to be decided.
+  - amounts = row i holds the request of procs[i].
+
+Description:
+	Decide every request in turn and return the answer to each. The requests granted
+  form a maximal set: adding any denied request to them leaves the state unsafe.
+********************************************/
+vector<int> batch_admitter::admit_all(const vector<int>& procs, const matrix& amounts)
+{
+  vector<int> answers(procs.size());
+  for(size_t i = 0; i < procs.size(); i++)
+  {
+    answers[i] = admit(procs[i], amounts.row(i).data);
+  }
+  return answers;
+}
+
+#endif /* batch_h */
@@ -0,0 +1,1456 @@
+/********************************************
+File Name: 			bench.cc
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Procedures:
+
+	main() : A benchmark program for the Banker's algorithm. Times the row comparison
+  kernels and the safety checkers on randomly generated states.
+
+  Usage: bench
+         bench threads [n] [m]
+         bench parse [n] [m]
+         bench detect [n] [m]
+         bench suite [csv_file]
+         bench alloc [n] [m]
+         bench pools [n]
+         bench cache [n] [m]
+         bench fixed [n]
+         bench sequences [n] [m]
+         bench decision [n] [m]
+         bench verify [seconds]
+
+  bench alloc and the allocation counts of bench decision need the program built with
+  -Dbench_heap, which replaces operator new with one that counts every call. It is left out
+  otherwise so that the other modes, bench threads above all, don't share a counter on every
+  allocation.
+
+	bench_kernels() : Time the scalar, SSE2 and AVX2 row comparison kernels.
+
+	chain_state() : Generate a safe state whose processes can only run in reverse.
+
+	time_check() : Time a full safety check with one checker.
+
+	bench_checkers() : Time a full safety check with the rescans, the incremental and the adaptive
+  checker on generated states and on a chain.
+
+	deadlocked_state() : Generate an unsafe state where every process but two can run.
+
+	bench_threads() : Time the parallel admission loop on 1 to 64 threads.
+
+	load_stream() : Read an input file one int at a time with fstream, as main() used to.
+
+	bench_parse() : Time reading a large input with fstream, the mapped scanner and a snapshot.
+
+	bench_detect() : Time full and incremental deadlock detection on large states and graphs.
+
+	bench_suite() : Time every stage on a grid of generated workloads and write a csv file.
+
+	operator new() : Counts every heap allocation the program makes, with -Dbench_heap.
+
+	bench_alloc() : Count the heap allocations made by safe() with and without a workspace.
+
+	bench_pools() : Time the safety check over pools of sockets and cores as the cores grow.
+
+	bench_cache() : Time the admission service on resubmitted jobs with and without its cache.
+
+	bench_fixed_m() : Time safe() against safe_fixed() for one fixed number of resources.
+
+	bench_fixed() : Run bench_fixed_m() for every number of resources fixed.h is specialised for.
+
+	bench_sequences() : Time counting the safe sequences on 1 to 16 threads and ranking them.
+
+	bench_decision() : Time the admission loop with a route string against a decision record.
+
+	valid_sequence() : Check that a sequence runs every process of a state to completion.
+
+	route_sequence() : Read the processes of a route back into a sequence.
+
+	verify_fixed() : Run safe_fixed() on a state with M resources.
+
+	bench_verify() : Check every engine against safe_reference() on random states for a while.
+
+********************************************/
+#include "header.h"
+#include "parallel.h"
+#include "parser.h"
+#include "detect.h"
+#include "workload.h"
+#include "pools.h"
+#include "service.h"
+#include "fixed.h"
+#include "sequences.h"
+#include "decision.h"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+
+/* Macro denoting the number of times each timed loop is repeated */
+#define bench_reps 20
+
+#ifdef bench_heap
+/* Number of calls to operator new so far, counted by the replacement below */
+atomic<long> heap_allocations(0);
+
+/********************************************
+Procedure Name: operator new()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - size = the number of bytes asked for.
+
+Description:
+	Replaces the global operator new so that every heap allocation of the program, the
+  containers of the standard library included, is counted. The matrix buffers are
+  counted too, through the control block of their shared pointer. Only built with
+  -Dbench_heap.
+********************************************/
+void* operator new(size_t size)
+{
+  heap_allocations++;
+  void* p = malloc(size == 0 ? 1 : size);
+  if(p == NULL)
+    throw bad_alloc();
+  return p;
+}
+
+//Kept out of line, so the compiler doesn't pair the inlined free() with operator new.
+__attribute__((noinline)) void operator delete(void* p) noexcept
+{
+  free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept
+{
+  free(p);
+}
+#endif /* bench_heap */
+
+/********************************************
+Procedure Name: seconds_since()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - start = the time point the measurement started at.
+
+Description:
+	The number of seconds elapsed since start.
+********************************************/
+double seconds_since(chrono::steady_clock::time_point start)
+{
+  return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+/********************************************
+Procedure Name: bench_kernels()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+
+Description:
+	Time the row comparison kernels on 4096 rows that all pass, so every kernel has to
+  look at the whole row, for row widths of 64 to 512 resources.
+********************************************/
+void bench_kernels(mt19937 &gen)
+{
+  const char* names[3] = {"scalar", "sse2", "avx2"};
+  row_le_fn kernels[3] = {row_le_scalar, NULL, NULL};
+#ifdef kernel_x86
+  kernels[1] = row_le_sse2;
+  if(__builtin_cpu_supports("avx2"))
+    kernels[2] = row_le_avx2;
+#endif
+
+  cout << "Row compare kernels (ns per row, speedup over scalar)\n";
+  for(int m = 64; m <= 512; m *= 2)
+  {
+    int n = 4096;
+    matrix rows(n, m);
+    vector<int> available(m, 100);
+    for(int i = 0; i < n; i++)
+    {
+      int* r = rows.mutable_row(i);
+      for(int j = 0; j < m; j++)
+      {
+        r[j] = gen() % 101;
+      }
+    }
+
+    double scalar_ns = 0;
+    cout << "m = " << m << ":";
+    for(int k = 0; k < 3; k++)
+    {
+      if(kernels[k] == NULL)
+        continue;
+      int passed = 0;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      for(int rep = 0; rep < bench_reps; rep++)
+      {
+        for(int i = 0; i < n; i++)
+        {
+          passed += kernels[k](rows.row(i).data, available.data(), m);
+        }
+      }
+      double ns = seconds_since(start) * 1e9 / ((double)n * bench_reps);
+      if(k == 0)
+        scalar_ns = ns;
+      //passed is printed so the loop can't be optimised away.
+      cout << "  " << names[k] << " = " << ns << " (" << scalar_ns / ns << "x, " << passed / bench_reps << ")";
+    }
+    cout << endl;
+  }
+  cout << endl;
+}
+
+/********************************************
+Procedure Name: chain_state()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - x = the state to be filled in.
+  - n & m = number of processes and resources.
+
+Description:
+	Generate a safe state where the processes can only run in reverse. Every process holds
+  one unit of every resource and process i needs n - i more, with one unit of each
+  available, so only the last process can run and each one that finishes frees just
+  enough for the one before it. A rescan in order passes over every process left before
+  it finds the last, O(n^2) rows in all.
+********************************************/
+void chain_state(struct state &x, int n, int m)
+{
+  x.claim = matrix(n, m);
+  x.allocation = matrix(n, m);
+  x.resource.assign(m, n + 1);
+  x.available.assign(m, 1);
+  for(int i = 0; i < n; i++)
+  {
+    int* claim = x.claim.mutable_row(i);
+    int* allocation = x.allocation.mutable_row(i);
+    for(int j = 0; j < m; j++)
+    {
+      claim[j] = n - i + 1;
+      allocation[j] = 1;
+    }
+  }
+  compute_need(x, n, m);
+  x.request = x.need;
+}
+
+/********************************************
+Procedure Name: time_check()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - c = the checker to be timed.
+  - x = the state to be checked.
+  - order = the processes in the order they are checked.
+  - m = number of resources.
+
+Description:
+	The ms per full safety check of x with c, repeated for at least a tenth of a second
+  or bench_reps times, whichever is longer, so short checks are timed over many runs.
+********************************************/
+template <class checker>
+double time_check(checker& c, const state& x, const vector<int>& order, int m)
+{
+  int runs = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  do
+  {
+    c.start(x.need, x.allocation, x.available, order, m);
+    while(c.next() != -1);
+    runs++;
+  } while(runs < bench_reps || seconds_since(start) < 0.1);
+  return seconds_since(start) * 1e3 / runs;
+}
+
+/********************************************
+Procedure Name: bench_checkers()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+
+Description:
+	Time a full safety check with the scalar rescan, the packed compare rescan, the
+  incremental checker and the adaptive checker safe() uses. The states are generated
+  safe ones (see workload.h), with 10 units of every resource to spare and with none,
+  and the chain of chain_state(), where the rescans pass over every process left at
+  every step. The processes are checked in order, as admit() checks them.
+********************************************/
+void bench_checkers(mt19937 &gen)
+{
+  const int procs[2] = {2000, 10000};
+  const int resources[2] = {8, 64};
+  const char* shapes[3] = {"slack 10", "slack 0", "chain"};
+
+  cout << "Safety checkers (ms per check)\n";
+  for(int a = 0; a < 2; a++)
+  for(int b = 0; b < 2; b++)
+  for(int shape = 0; shape < 3; shape++)
+  {
+    int n = procs[a], m = resources[b];
+    state x;
+    if(shape == 2)
+    {
+      chain_state(x, n, m);
+    }
+    else
+    {
+      workload w = {n, m, 1.0, shape == 0 ? 10 : 0, true, 100};
+      generate_state(x, w, gen);
+    }
+    vector<int> order(n);
+    for(int i = 0; i < n; i++)
+    {
+      order[i] = i;
+    }
+
+    rescan_checker r;
+    simd_checker v;
+    incremental_checker c;
+    adaptive_checker d;
+    double rescan_ms = time_check(r, x, order, m);
+    double simd_ms = time_check(v, x, order, m);
+    double incremental_ms = time_check(c, x, order, m);
+    double adaptive_ms = time_check(d, x, order, m);
+
+    cout << "n = " << n << ", m = " << m << ", " << shapes[shape] << ":  rescan = " << rescan_ms
+         << "  " << row_le_name() << " rescan = " << simd_ms << " (" << rescan_ms / simd_ms << "x)"
+         << "  incremental = " << incremental_ms << " (" << rescan_ms / incremental_ms << "x)"
+         << "  adaptive = " << adaptive_ms << " (" << rescan_ms / adaptive_ms << "x)" << endl;
+  }
+  cout << endl;
+}
+
+/********************************************
+Procedure Name: deadlocked_state()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - x = the state to be filled in.
+  - n & m = number of processes and resources.
+  - gen = the random number generator to draw from.
+
+Description:
+	Generate an unsafe state with n processes and m resources. The last two processes each
+  hold a large share of resource 0 and need as much again, so they can never both
+  finish. Every other process has a small need that fits in what is available, so the
+  admission loop runs a full safety check for each of them before giving up.
+********************************************/
+void deadlocked_state(struct state &x, int n, int m, mt19937 &gen)
+{
+  uniform_int_distribution<int> claims(0, 10);
+  x.claim = matrix(n, m);
+  x.allocation = matrix(n, m);
+  x.request = matrix(n, m);
+  x.resource.assign(m, 10);
+
+  for(int i = 0; i < n - 2; i++)
+  {
+    int* claim = x.claim.mutable_row(i);
+    int* allocation = x.allocation.mutable_row(i);
+    for(int j = 0; j < m; j++)
+    {
+      claim[j] = claims(gen);
+      allocation[j] = uniform_int_distribution<int>(0, claim[j])(gen);
+      x.resource[j] += allocation[j];
+    }
+  }
+
+  //Each needs one more than everything the others can give back, so neither can finish.
+  int share = x.resource[0];
+  for(int i = n - 2; i < n; i++)
+  {
+    x.claim.mutable_row(i)[0] = 2 * share + 1;
+    x.allocation.mutable_row(i)[0] = share;
+  }
+  x.resource[0] += 2 * share;
+
+  x.available = x.resource;
+  for(int i = 0; i < n; i++)
+  {
+    row_view claim = x.claim.row(i);
+    row_view allocation = x.allocation.row(i);
+    int* request = x.request.mutable_row(i);
+    for(int j = 0; j < m; j++)
+    {
+      request[j] = claim[j] - allocation[j];
+      x.available[j] -= allocation[j];
+    }
+  }
+  compute_need(x, n, m);
+}
+
+/********************************************
+Procedure Name: bench_threads()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n & m = number of processes and resources.
+
+Description:
+	Time the parallel admission loop on 1, 2, 4, ... 64 threads on a deadlocked state,
+  where every candidate needs its own full safety check. Nothing is traced.
+********************************************/
+void bench_threads(mt19937 &gen, int n, int m)
+{
+  state x;
+  deadlocked_state(x, n, m, gen);
+  ostringstream sink;
+  tracer quiet(sink, trace_off);
+
+  cout << "Parallel admission, n = " << n << ", m = " << m << " (s, speedup over 1 thread)\n";
+  double one = 0;
+  for(int threads = 1; threads <= 64; threads *= 2)
+  {
+    thread_pool pool(threads);
+    string route;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    bool found = parallel_admit(&x, n, m, pool, &quiet, &route);
+    double secs = seconds_since(start);
+    if(threads == 1)
+      one = secs;
+    cout << "threads = " << threads << ": " << secs << " (" << one / secs << "x)"
+         << (found ? " safe" : " unsafe") << endl;
+  }
+  cout << endl;
+}
+
+/********************************************
+Procedure Name: load_stream()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the input file.
+  - info = the state to be filled in.
+  - n & m = where the number of processes and resources are stored.
+
+Description:
+	Read an input file one int at a time with fstream >>, the way main() read it before
+  parser.h, kept to compare the parsers against.
+********************************************/
+void load_stream(const char* path, struct state& info, int& n, int& m)
+{
+  fstream fs(path, fstream::in);
+  fs >> m;
+  info.resource.assign(m, 0);
+  for(int j = 0; j < m; j++)
+  {
+    fs >> info.resource[j];
+  }
+  info.available = info.resource;
+  fs >> n;
+  info.claim = matrix(n, m);
+  info.allocation = matrix(n, m);
+  info.need = matrix(n, m);
+  for(int i = 0; i < n; i++)
+  {
+    int* claim = info.claim.mutable_row(i);
+    for(int j = 0; j < m; j++)
+    {
+      fs >> claim[j];
+    }
+  }
+  for(int i = 0; i < n; i++)
+  {
+    row_view claim = info.claim.row(i);
+    int* allocation = info.allocation.mutable_row(i);
+    int* need = info.need.mutable_row(i);
+    for(int j = 0; j < m; j++)
+    {
+      fs >> allocation[j];
+      info.available[j] -= allocation[j];
+      need[j] = claim[j] - allocation[j];
+    }
+  }
+  info.request = info.need;
+}
+
+/********************************************
+Procedure Name: bench_parse()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n & m = number of processes and resources.
+
+Description:
+	Write a random n x m state out as a text input and as a snapshot, then time reading
+  it back with fstream, with the mapped from_chars scanner and by mapping the snapshot.
+  The files are written to the current directory and removed afterwards.
+********************************************/
+void bench_parse(mt19937 &gen, int n, int m)
+{
+  const char* text_file = "bench_input.txt";
+  const char* snapshot_file = "bench_input.bin";
+  state x;
+  workload shape = {n, m, 1.0, 10, true, 100};
+  generate_state(x, shape, gen);
+
+  if(!write_text(text_file, x, n, m))
+    return;
+  save_snapshot(snapshot_file, x, n, m);
+
+  cout << "Reading an input, n = " << n << ", m = " << m << " (ms, speedup over fstream)\n";
+  int rn = 0, rm = 0;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  state a;
+  load_stream(text_file, a, rn, rm);
+  double stream_ms = seconds_since(start) * 1e3;
+
+  start = chrono::steady_clock::now();
+  state b;
+  bool text_ok = load_text(text_file, b, rn, rm);
+  double text_ms = seconds_since(start) * 1e3;
+
+  start = chrono::steady_clock::now();
+  state c;
+  bool snapshot_ok = load_snapshot(snapshot_file, c, rn, rm);
+  double snapshot_ms = seconds_since(start) * 1e3;
+
+  //All three have to agree with the state written out.
+  bool same = text_ok && snapshot_ok;
+  for(int i = 0; i < n && same; i++)
+  {
+    same = equal(a.need.row(i).begin(), a.need.row(i).end(), x.need.row(i).begin())
+        && equal(b.need.row(i).begin(), b.need.row(i).end(), x.need.row(i).begin())
+        && equal(c.need.row(i).begin(), c.need.row(i).end(), x.need.row(i).begin());
+  }
+  same = same && a.available == x.available && b.available == x.available && c.available == x.available;
+
+  cout << "fstream = " << stream_ms << "  mapped text = " << text_ms << " (" << stream_ms / text_ms << "x)"
+       << "  snapshot = " << snapshot_ms << " (" << stream_ms / snapshot_ms << "x)"
+       << (same ? "" : "  MISMATCH") << endl << endl;
+  remove(text_file);
+  remove(snapshot_file);
+}
+
+/********************************************
+Procedure Name: bench_detect()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n & m = number of processes and resources of the multi unit state.
+
+Description:
+	Time the first, full detection and then detections after every 16 random changes,
+  for the detector on a random n x m state with every process asking for the rest of its
+  claim, and for the wait-for graph of n processes that each hold a resource of their own
+  and wait for another one half of the time. Some processes are set up to deadlock in
+  both. The incremental answers are checked against a detector built from scratch at the
+  end.
+********************************************/
+void bench_detect(mt19937 &gen, int n, int m)
+{
+  const int rounds = 200;
+  const int changes = 16;
+
+  //Multi unit resources, a safe state with some processes made to ask for too much.
+  state x;
+  workload shape = {n, m, 1.0, 10, true, 100};
+  generate_state(x, shape, gen);
+  x.request = x.need;
+  for(int i = 0; i < n; i += 1000)
+  {
+    x.request.mutable_row(i)[0] = x.resource[0];
+  }
+
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  deadlock_detector d(x, n, m);
+  size_t found = d.detect().size();
+  double full_ms = seconds_since(start) * 1e3;
+
+  double total_ms = 0, worst_ms = 0;
+  vector<int> alloc(m), req(m);
+  for(int round = 0; round < rounds; round++)
+  {
+    //Processes give back or take a unit of a resource and change their requests.
+    for(int c = 0; c < changes; c++)
+    {
+      int p = gen() % n;
+      int j = gen() % m;
+      row_view a = x.allocation.row(p);
+      row_view q = x.request.row(p);
+      copy(a.begin(), a.end(), alloc.begin());
+      copy(q.begin(), q.end(), req.begin());
+      if(alloc[j] > 0 && gen() % 2)
+        alloc[j]--;
+      else if(x.available[j] > 0)
+        alloc[j]++;
+      req[j] = gen() % 101;
+      d.update(p, alloc.data(), req.data());
+      x.available[j] -= alloc[j] - a[j];
+      copy(alloc.begin(), alloc.end(), x.allocation.mutable_row(p));
+      copy(req.begin(), req.end(), x.request.mutable_row(p));
+    }
+    start = chrono::steady_clock::now();
+    found = d.detect().size();
+    double ms = seconds_since(start) * 1e3;
+    total_ms += ms;
+    worst_ms = max(worst_ms, ms);
+  }
+  deadlock_detector fresh(x, n, m);
+  cout << "Deadlock detection (ms)\n"
+       << "multi unit, n = " << n << ", m = " << m << ":  full = " << full_ms
+       << "  incremental mean = " << total_ms / rounds << ", max = " << worst_ms
+       << "  (" << found << " deadlocked" << (fresh.detect() == d.detect() ? "" : ", MISMATCH") << ")" << endl;
+
+  //Single unit resources, every process holds resource p and some wait for another.
+  wait_for_graph g(n, n);
+  vector<int> waiting(n, -1);
+  for(int p = 0; p < n; p++)
+  {
+    g.acquire(p, p);
+  }
+  for(int p = 0; p < n; p++)
+  {
+    if(gen() % 2 == 0)
+    {
+      waiting[p] = gen() % n;
+    }
+  }
+  //Pairs of processes that wait for each other, so there is something to find.
+  for(int p = 0; p + 1 < n; p += 1000)
+  {
+    waiting[p] = p + 1;
+    waiting[p + 1] = p;
+  }
+  for(int p = 0; p < n; p++)
+  {
+    if(waiting[p] != -1)
+      g.wait(p, waiting[p]);
+  }
+
+  start = chrono::steady_clock::now();
+  found = g.detect().size();
+  full_ms = seconds_since(start) * 1e3;
+
+  total_ms = worst_ms = 0;
+  for(int round = 0; round < rounds; round++)
+  {
+    //Processes stop waiting or start waiting for something else.
+    for(int c = 0; c < changes; c++)
+    {
+      int p = gen() % n;
+      if(waiting[p] != -1)
+      {
+        g.cancel(p, waiting[p]);
+        waiting[p] = -1;
+      }
+      else
+      {
+        waiting[p] = gen() % n;
+        g.wait(p, waiting[p]);
+      }
+    }
+    start = chrono::steady_clock::now();
+    found = g.detect().size();
+    double ms = seconds_since(start) * 1e3;
+    total_ms += ms;
+    worst_ms = max(worst_ms, ms);
+  }
+
+  wait_for_graph check(n, n);
+  for(int p = 0; p < n; p++)
+  {
+    check.acquire(p, p);
+    if(waiting[p] != -1)
+      check.wait(p, waiting[p]);
+  }
+  cout << "single unit, n = " << n << ":  full = " << full_ms
+       << "  incremental mean = " << total_ms / rounds << ", max = " << worst_ms
+       << "  (" << found << " deadlocked" << (check.detect() == g.detect() ? "" : ", MISMATCH") << ")" << endl << endl;
+}
+
+/********************************************
+Procedure Name: bench_suite()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - csv_file = the file the results are written to.
+
+Description:
+	Generate a safe and an unsafe state for every combination of the number of processes
+  and resources, claim density and slack in the grid below, and time separately:
+  reading the state back from a text input, one state_copy(), one safe() on the whole
+  state and the whole admission loop of admit(). Nothing is traced. Every row of the
+  csv file holds the shape of a state, whether it was safe and the four times, so runs
+  can be plotted against each other.
+********************************************/
+void bench_suite(mt19937 &gen, const char* csv_file)
+{
+  const int procs[4] = {250, 500, 1000, 2000};
+  const int resources[3] = {8, 32, 128};
+  const double densities[2] = {0.25, 1.0};
+  const int slacks[2] = {0, 10};
+  const char* text_file = "bench_input.txt";
+  ostringstream sink;
+  tracer quiet(sink, trace_off);
+
+  /* Instantiate a file stream object and supply the names of the columns */
+  fstream ops;
+  ops.open(csv_file, fstream::out | fstream::trunc);
+  ops << "NumProcs,NumRes,Density,Slack,Workload,Safe,ParseMs,StateCopyUs,SafeMs,AdmitMs" << endl;
+
+  for(int a = 0; a < 4; a++)
+  for(int b = 0; b < 3; b++)
+  for(int c = 0; c < 2; c++)
+  for(int d = 0; d < 2; d++)
+  for(int kind = 1; kind >= 0; kind--)
+  {
+    workload w = {procs[a], resources[b], densities[c], slacks[d], kind == 1, 100};
+    int n = w.n, m = w.m;
+    state x;
+    bool is_safe = generate_state(x, w, gen);
+
+    //Read it back from a text input.
+    write_text(text_file, x, n, m);
+    state y;
+    int rn = 0, rm = 0;
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    load_text(text_file, y, rn, rm);
+    double parse_ms = seconds_since(start) * 1e3;
+    remove(text_file);
+
+    //A copy, with the first write to it so the matrix it touches is detached.
+    start = chrono::steady_clock::now();
+    for(int rep = 0; rep < bench_reps; rep++)
+    {
+      state z;
+      state_copy(&z, &x);
+      state_grant(&z, &x, rep % n, m);
+    }
+    double copy_us = seconds_since(start) * 1e6 / bench_reps;
+
+    //A safety check of the whole state.
+    vector<int> rest(n - 1);
+    for(int i = 1; i < n; i++)
+    {
+      rest[i - 1] = i;
+    }
+    string route;
+    start = chrono::steady_clock::now();
+    for(int rep = 0; rep < bench_reps; rep++)
+    {
+      safe(&x, n, m, 0, vector<int>(), rest, &route, &quiet);
+    }
+    double safe_ms = seconds_since(start) * 1e3 / bench_reps;
+
+    //The admission loop, which runs a check for every candidate it gets to.
+    start = chrono::steady_clock::now();
+    admit(&x, n, m, &route, &quiet);
+    double admit_ms = seconds_since(start) * 1e3;
+    sink.str("");
+
+    cout << "n = " << n << ", m = " << m << ", density = " << w.density << ", slack = " << w.slack
+         << (is_safe ? ", safe" : ", unsafe") << ":  parse = " << parse_ms << " ms  state_copy = "
+         << copy_us << " us  safe = " << safe_ms << " ms  admit = " << admit_ms << " ms" << endl;
+    ops << n << "," << m << "," << w.density << "," << w.slack << "," << (w.safe ? "safe" : "unsafe")
+        << "," << is_safe << "," << parse_ms << "," << copy_us << "," << safe_ms << "," << admit_ms << endl;
+  }
+
+  /* Close the output csv file */
+  ops.close();
+  cout << "Results written to " << csv_file << endl << endl;
+}
+
+/********************************************
+Procedure Name: bench_alloc()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n & m = number of processes and resources.
+
+Description:
+	Count the heap allocations of safe() on a random safe state, first making a new
+  workspace for every call and then with one workspace kept between calls. After a
+  first call to grow its buffers the second has to make none. Then count the
+  allocations of a whole admit() run on a deadlocked state, which checks every
+  candidate with one workspace. Only built with -Dbench_heap.
+********************************************/
+#ifdef bench_heap
+void bench_alloc(mt19937 &gen, int n, int m)
+{
+  const int calls = 100;
+  state x;
+  workload shape = {n, m, 1.0, 10, true, 100};
+  generate_state(x, shape, gen);
+  ostringstream sink;
+  tracer quiet(sink, trace_off);
+  vector<int> none;
+  vector<int> rest(n - 1);
+  for(int i = 1; i < n; i++)
+  {
+    rest[i - 1] = i;
+  }
+  string route;
+  route.reserve(16 * n);
+
+  cout << "Heap allocations, n = " << n << ", m = " << m << "\n";
+  long before = heap_allocations;
+  for(int call = 0; call < calls; call++)
+  {
+    route.clear();
+    safe(&x, n, m, 0, none, rest, &route, &quiet);
+  }
+  cout << "safe() with a new workspace: " << (double)(heap_allocations - before) / calls << " per call" << endl;
+
+  workspace<adaptive_checker> w;
+  route.clear();
+  safe(&x, n, m, 0, none, rest, &route, &quiet, &w);
+  before = heap_allocations;
+  for(int call = 0; call < calls; call++)
+  {
+    route.clear();
+    safe(&x, n, m, 0, none, rest, &route, &quiet, &w);
+  }
+  cout << "safe() with a kept workspace: " << (double)(heap_allocations - before) / calls << " per call" << endl;
+
+  state y;
+  deadlocked_state(y, n, m, gen);
+  route.clear();
+  before = heap_allocations;
+  admit(&y, n, m, &route, &quiet);
+  cout << "admit() over " << n << " candidates: " << heap_allocations - before << " in all" << endl << endl;
+}
+#endif /* bench_heap */
+
+/********************************************
+Procedure Name: bench_pools()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n = number of processes.
+
+Description:
+	Time the safety check of pool_state on trees of 16 sockets with 1024 up to 65536
+  cores between them, two units each. Every process claims a few units of the machine,
+  of one socket and of one core, and is granted part of them first. The time of a check
+  should stay the same however many cores there are.
+********************************************/
+void bench_pools(mt19937 &gen, int n)
+{
+  cout << "Pool safety check, n = " << n << " (ms per check, ms per request)\n";
+  for(int cores = 1024; cores <= 65536; cores *= 4)
+  {
+    resource_tree tree;
+    vector<int> sockets, leaves;
+    for(int k = 0; k < 16; k++)
+    {
+      sockets.push_back(tree.add_pool(0));
+    }
+    for(int c = 0; c < cores; c++)
+    {
+      leaves.push_back(tree.add_leaf(sockets[c % 16], 2));
+    }
+
+    pool_state x(tree);
+    for(int p = 0; p < n; p++)
+    {
+      vector<pool_demand> claim;
+      claim.push_back(pool_demand{0, (int)(gen() % 8) + 1});
+      claim.push_back(pool_demand{sockets[gen() % 16], (int)(gen() % 4) + 1});
+      claim.push_back(pool_demand{leaves[gen() % cores], (int)(gen() % 2) + 1});
+      x.add_process(claim);
+    }
+
+    //Hand out part of every claim, each request runs a check of its own.
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    int granted = 0;
+    for(int p = 0; p < n; p++)
+    {
+      granted += x.request(p, gen() % 3, 1) == event_grant;
+    }
+    double request_ms = seconds_since(start) * 1e3 / n;
+
+    start = chrono::steady_clock::now();
+    bool found = false;
+    for(int rep = 0; rep < bench_reps; rep++)
+    {
+      found = x.safe();
+    }
+    double safe_ms = seconds_since(start) * 1e3 / bench_reps;
+    cout << "cores = " << cores << ":  safe = " << safe_ms << "  request = " << request_ms
+         << "  (" << granted << " granted" << (found ? ", safe)" : ", unsafe)") << endl;
+  }
+  cout << endl;
+}
+
+/********************************************
+Procedure Name: bench_cache()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n & m = number of processes and resources.
+
+Description:
+	Run the same stream of events through the admission service with its cache of
+  safety checks and without. A few jobs keep being resubmitted: a random one of them
+  asks for one unit of every resource and then gives everything back, so the same
+  states come round again and again. Both services have to give the same answers.
+********************************************/
+void bench_cache(mt19937 &gen, int n, int m)
+{
+  const int events = 20000;
+  state x;
+  workload shape = {n, m, 1.0, 10, true, 100};
+  generate_state(x, shape, gen);
+  vector<int> procs(events);
+  for(int e = 0; e < events; e++)
+  {
+    procs[e] = gen() % 8;
+  }
+  vector<int> one(m, 1);
+
+  cout << "Admission service on resubmitted jobs, n = " << n << ", m = " << m << " (us per event)\n";
+  vector<int> answers[2];
+  for(int cached = 1; cached >= 0; cached--)
+  {
+    admission_service service(x, n, m, cached ? default_cache_bytes : 0);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for(int e = 0; e < events; e++)
+    {
+      answers[cached].push_back(service.request(procs[e], one.data()));
+      service.release(procs[e], one.data());
+    }
+    double us = seconds_since(start) * 1e6 / events;
+    cout << (cached ? "cache:    " : "no cache: ") << us;
+    if(cached)
+      cout << "  (" << service.checks().hits << " hits, " << service.checks().misses << " misses, "
+           << service.checks().size() << " entries)";
+    cout << endl;
+  }
+  cout << (answers[0] == answers[1] ? "" : "MISMATCH\n") << endl;
+}
+
+/********************************************
+Procedure Name: bench_fixed_m()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n = number of processes.
+
+Description:
+	Time a safety check of a generated safe state with M resources and no slack, so most
+  processes wait on some resource, by safe() and by safe_fixed(). Both keep their
+  workspace between checks and have to find the same route.
+********************************************/
+template <int M>
+void bench_fixed_m(mt19937 &gen, int n)
+{
+  workload wl = {n, M, 1.0, 0, true, 100};
+  state x;
+  generate_state(x, wl, gen);
+  ostringstream sink;
+  tracer quiet(sink, trace_off);
+  vector<int> none;
+  vector<int> rest(n - 1);
+  for(int i = 1; i < n; i++)
+  {
+    rest[i - 1] = i;
+  }
+  string route[2];
+
+  workspace<adaptive_checker> w;
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for(int rep = 0; rep < bench_reps; rep++)
+  {
+    route[0].clear();
+    safe(&x, n, M, 0, none, rest, &route[0], &quiet, &w);
+  }
+  double dynamic_ms = seconds_since(start) * 1e3 / bench_reps;
+
+  workspace<fixed_checker<M> > fw;
+  start = chrono::steady_clock::now();
+  for(int rep = 0; rep < bench_reps; rep++)
+  {
+    route[1].clear();
+    safe_fixed(&x, n, 0, none, rest, &route[1], &quiet, fw);
+  }
+  double fixed_ms = seconds_since(start) * 1e3 / bench_reps;
+
+  cout << "m = " << M << ":  safe = " << dynamic_ms << "  safe_fixed = " << fixed_ms
+       << " (" << dynamic_ms / fixed_ms << "x)" << (route[0] == route[1] ? "" : "  MISMATCH") << endl;
+}
+
+/********************************************
+Procedure Name: bench_fixed()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n = number of processes.
+
+Description:
+	Compare the dynamic and specialised safety checks for m = 2, 3, 4, 6 and 8.
+********************************************/
+void bench_fixed(mt19937 &gen, int n)
+{
+  cout << "Dynamic and fixed resource counts, n = " << n << " (ms per check)\n";
+  bench_fixed_m<2>(gen, n);
+  bench_fixed_m<3>(gen, n);
+  bench_fixed_m<4>(gen, n);
+  bench_fixed_m<6>(gen, n);
+  bench_fixed_m<8>(gen, n);
+  cout << endl;
+}
+
+/********************************************
+Procedure Name: bench_sequences()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n & m = number of processes and resources.
+
+Description:
+	Count the safe sequences of a generated safe state with no slack on 1, 2, 4, 8 and 16
+  threads, every thread count has to give the same count, and find the 10 with the
+  lowest peak. Then count them for 2n processes with a budget of one second.
+********************************************/
+void bench_sequences(mt19937 &gen, int n, int m)
+{
+  workload wl = {n, m, 0.5, 0, true, 10};
+  state x;
+  generate_state(x, wl, gen);
+
+  cout << "Safe sequences, n = " << n << ", m = " << m << " (ms)\n";
+  seq_count first = 0;
+  for(int threads = 1; threads <= 16; threads *= 2)
+  {
+    thread_pool pool(threads);
+    sequence_search search(x, n, m);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    seq_count count = search.count(&pool);
+    double count_ms = seconds_since(start) * 1e3;
+    if(threads == 1)
+      first = count;
+    cout << threads << " threads:  count = " << count_ms << " (" << count_text(count) << " sequences, "
+         << search.memo_size() << " sets)" << (count == first ? "" : "  MISMATCH") << endl;
+  }
+
+  sequence_search search(x, n, m);
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  vector<ranked_sequence> best = search.best(10, cost_peak);
+  cout << "best 10 by peak = " << seconds_since(start) * 1e3 << " (" << search.memo_size() << " sets, peak "
+       << (best.empty() ? 0 : best[0].cost) << ")" << endl;
+
+  wl.n = 2 * n;
+  state y;
+  generate_state(y, wl, gen);
+  thread_pool pool(thread::hardware_concurrency());
+  sequence_search large(y, wl.n, m);
+  large.set_budget(1.0);
+  start = chrono::steady_clock::now();
+  seq_count count = large.count(&pool);
+  cout << "n = " << wl.n << " with a 1 s budget: " << (large.complete() && count != seq_count_max ? "" : "at least ")
+       << count_text(count) << " sequences in " << seconds_since(start) * 1e3 << " ms" << endl << endl;
+}
+
+/********************************************
+Procedure Name: bench_decision()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - n & m = number of processes and resources.
+
+Description:
+	Time admit() building its route string with the tracer off against decide() filling
+  in a kept decision and writing it as JSON Lines and as a binary record to /dev/null,
+  and, built with -Dbench_heap, count the heap allocations of the decide() loop once it
+  has warmed up.
+********************************************/
+void bench_decision(mt19937 &gen, int n, int m)
+{
+  state x;
+  workload shape = {n, m, 1.0, 10, true, 100};
+  generate_state(x, shape, gen);
+  ostringstream sink;
+  tracer quiet(sink, trace_off);
+  FILE* null = fopen("/dev/null", "w");
+  record_writer out(null);
+  decision d;
+  workspace<adaptive_checker> w;
+  string route;
+
+  cout << "Decisions, n = " << n << ", m = " << m << " (ms per decision)\n";
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for(int rep = 0; rep < bench_reps; rep++)
+  {
+    route.clear();
+    admit(&x, n, m, &route, &quiet);
+  }
+  cout << "admit() with a route:     " << seconds_since(start) * 1e3 / bench_reps << endl;
+
+  const char* names[2] = {"decide() and jsonl:      ", "decide() and binary:     "};
+  for(int format = 0; format < 2; format++)
+  {
+    //One decision first, so the buffers have grown to size.
+    decide(&x, n, m, d, w);
+    if(format == 0)
+      out.jsonl(d, m);
+    else
+      out.binary(d, m);
+    start = chrono::steady_clock::now();
+#ifdef bench_heap
+    long before = heap_allocations;
+#endif
+    for(int rep = 0; rep < bench_reps; rep++)
+    {
+      decide(&x, n, m, d, w);
+      if(format == 0)
+        out.jsonl(d, m);
+      else
+        out.binary(d, m);
+    }
+    cout << names[format] << seconds_since(start) * 1e3 / bench_reps;
+#ifdef bench_heap
+    cout << "  (" << (double)(heap_allocations - before) / bench_reps << " allocations)";
+#endif
+    cout << endl;
+  }
+  fclose(null);
+  cout << endl;
+}
+
+/********************************************
+Procedure Name: valid_sequence()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - x = the state the sequence is for.
+  - n & m = number of processes and resources.
+  - seq = the processes in the order they are to run.
+
+Description:
+	Check that seq holds every process once and that each one's need fits in what is
+  available once the ones before it have finished, so seq proves x is safe.
+********************************************/
+bool valid_sequence(const state& x, int n, int m, const vector<int>& seq)
+{
+  if((int)seq.size() != n)
+    return false;
+  vector<int> avail = x.available;
+  vector<char> seen(n, 0);
+  for(size_t k = 0; k < seq.size(); k++)
+  {
+    int p = seq[k];
+    if(p < 0 || p >= n || seen[p] || !row_le_scalar(x.need.row(p).data, avail.data(), m))
+      return false;
+    seen[p] = 1;
+    row_view a = x.allocation.row(p);
+    for(int j = 0; j < m; j++)
+    {
+      avail[j] += a[j];
+    }
+  }
+  return true;
+}
+
+/********************************************
+Procedure Name: route_sequence()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - route = a route as run_safe() writes it, "P3 -> P1 -> ...".
+
+Description:
+	The processes of the route in order, counted from 0.
+********************************************/
+vector<int> route_sequence(const string& route)
+{
+  vector<int> seq;
+  const char* p = route.data();
+  const char* end = p + route.size();
+  while((p = find(p, end, 'P')) != end)
+  {
+    int q;
+    p = from_chars(p + 1, end, q).ptr;
+    seq.push_back(q - 1);
+  }
+  return seq;
+}
+
+/********************************************
+Procedure Name: verify_fixed()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - x, n, cur_proc, suspended, processes, route, t = as for safe().
+
+Description:
+	Check x, which has M resources, with safe_fixed().
+********************************************/
+template <int M>
+bool verify_fixed(state& x, int n, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t)
+{
+  workspace<fixed_checker<M> > w;
+  return safe_fixed(&x, n, cur_proc, suspended, processes, route, t, w);
+}
+
+/********************************************
+Procedure Name: bench_verify()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - gen = the random number generator to draw from.
+  - seconds = how long to keep generating states.
+
+Description:
+	A differential soak test of the engines. Every round generates a safe or unsafe
+  state of 1 to 300 processes and 1 to 64 resources with random requests, some over
+  the claim, and:
+    - checks it with safe_reference(), safe_simd(), safe() with a kept workspace,
+      safe_fixed() when m is 2, 3, 4, 6 or 8 and record_check(), all of which have to
+      give the same verdict and route, and the route of every one of them has to be a
+      valid sequence exactly when it says the state is safe;
+    - runs the admission loop with admit(), admit_dispatch(), parallel_admit() on 4
+      threads and decide(), which have to grant the same process with the same route
+      and print the same trace, and leave the state as it was.
+  A state that makes any of them disagree is written to verify_failure.txt. At the
+  end the number of checks per second of every engine is printed. Returns false if
+  anything disagreed.
+********************************************/
+bool bench_verify(mt19937 &gen, double seconds)
+{
+  const int resources[8] = {1, 2, 3, 4, 6, 8, 13, 64};
+  const char* engines[6] = {"reference", "simd", "adaptive", "fixed", "record", "admission"};
+  double engine_s[6] = {0, 0, 0, 0, 0, 0};
+  long engine_calls[6] = {0, 0, 0, 0, 0, 0};
+  ostringstream sink;
+  tracer quiet(sink, trace_off);
+  thread_pool pool(4);
+  workspace<adaptive_checker> w;
+  decision d;
+  long rounds = 0, failures = 0;
+
+  cout << "Differential soak of the safety engines for " << seconds << " s\n";
+  chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+  while(seconds_since(begin) < seconds)
+  {
+    rounds++;
+    int n = 1 + gen() % (gen() % 2 ? 12 : 300);
+    int m = resources[gen() % 8];
+    workload wl = {n, m, 0.1 + 0.9 * (gen() % 1000) / 1000.0, (int)(gen() % 4), gen() % 2 == 0, 1 + (int)(gen() % 20)};
+    state x;
+    generate_state(x, wl, gen);
+
+    //Random requests up to the need, one in twenty processes asks for one more than its claim.
+    for(int i = 0; i < n; i++)
+    {
+      row_view need = x.need.row(i);
+      int* request = x.request.mutable_row(i);
+      for(int j = 0; j < m; j++)
+      {
+        request[j] = need[j] > 0 ? gen() % (need[j] + 1) : 0;
+      }
+      if(gen() % 20 == 0)
+      {
+        int col = gen() % m;
+        request[col] = need[col] + 1;
+      }
+    }
+
+    //Check the state with a random process first and a random split of the rest.
+    int cur_proc = gen() % n;
+    vector<int> suspended, processes;
+    for(int i = 0; i < n; i++)
+    {
+      if(i != cur_proc)
+        (gen() % 3 == 0 ? suspended : processes).push_back(i);
+    }
+
+    string routes[5];
+    bool verdicts[5] = {false, false, false, false, false};
+    bool ran[5] = {true, true, true, false, true};
+    chrono::steady_clock::time_point start;
+    for(int e = 0; e < 5; e++)
+    {
+      start = chrono::steady_clock::now();
+      switch(e)
+      {
+        case 0: verdicts[e] = safe_reference(&x, n, m, cur_proc, suspended, processes, &routes[e], &quiet); break;
+        case 1: verdicts[e] = safe_simd(&x, n, m, cur_proc, suspended, processes, &routes[e], &quiet); break;
+        case 2: verdicts[e] = safe(&x, n, m, cur_proc, suspended, processes, &routes[e], &quiet, &w); break;
+        case 3:
+          ran[e] = true;
+          if(m == 2) verdicts[e] = verify_fixed<2>(x, n, cur_proc, suspended, processes, &routes[e], &quiet);
+          else if(m == 3) verdicts[e] = verify_fixed<3>(x, n, cur_proc, suspended, processes, &routes[e], &quiet);
+          else if(m == 4) verdicts[e] = verify_fixed<4>(x, n, cur_proc, suspended, processes, &routes[e], &quiet);
+          else if(m == 6) verdicts[e] = verify_fixed<6>(x, n, cur_proc, suspended, processes, &routes[e], &quiet);
+          else if(m == 8) verdicts[e] = verify_fixed<8>(x, n, cur_proc, suspended, processes, &routes[e], &quiet);
+          else ran[e] = false;
+          break;
+        case 4:
+          verdicts[e] = record_check(&x, m, cur_proc, suspended, processes, d, w);
+          //The route as run_safe() writes it, with an arrow after every process but the last of all n.
+          for(size_t k = 0; k < d.sequence.size(); k++)
+          {
+            routes[e] += "P" + to_string(d.sequence[k] + 1) + ((int)k + 1 < n ? " -> " : "");
+          }
+          break;
+      }
+      if(ran[e])
+      {
+        engine_s[e] += seconds_since(start);
+        engine_calls[e]++;
+      }
+    }
+
+    string failure;
+    for(int e = 1; e < 5; e++)
+    {
+      if(ran[e] && (verdicts[e] != verdicts[0] || routes[e] != routes[0]))
+        failure += string(engines[e]) + " gave " + (verdicts[e] ? "safe " : "unsafe ") + routes[e] + "\n";
+    }
+    for(int e = 0; e < 5; e++)
+    {
+      if(ran[e] && verdicts[e] != valid_sequence(x, n, m, e == 4 ? d.sequence : route_sequence(routes[e])))
+        failure += string(engines[e]) + " gave the sequence " + routes[e] + ", which is not a proof of its verdict\n";
+    }
+
+    //The admission loops, which must leave the state as they found it.
+    state before;
+    state_copy(&before, &x);
+    string admitted[4];
+    ostringstream texts[4];
+    bool found[4];
+    start = chrono::steady_clock::now();
+    {
+      tracer t0(texts[0], trace_route), t1(texts[1], trace_route), t2(texts[2], trace_route);
+      found[0] = admit(&x, n, m, &admitted[0], &t0);
+      found[1] = admit_dispatch(&x, n, m, &admitted[1], &t1);
+      found[2] = parallel_admit(&x, n, m, pool, &t2, &admitted[2]);
+      found[3] = decide(&x, n, m, d, w);
+    }
+    engine_s[5] += seconds_since(start);
+    engine_calls[5] += 4;
+    if(found[3])
+    {
+      for(size_t k = 0; k < d.sequence.size(); k++)
+      {
+        admitted[3] += "P" + to_string(d.sequence[k] + 1) + (k + 1 < d.sequence.size() ? " -> " : "");
+      }
+    }
+    for(int e = 1; e < 4; e++)
+    {
+      if(found[e] != found[0] || admitted[e] != admitted[0] || (e < 3 && texts[e].str() != texts[0].str()))
+        failure += string("admission ") + (e == 1 ? "admit_dispatch" : e == 2 ? "parallel_admit" : "decide")
+                   + " gave " + admitted[e] + " instead of " + admitted[0] + "\n";
+    }
+    for(int i = 0; i < n && failure.empty(); i++)
+    {
+      if(!equal(x.allocation.row(i).begin(), x.allocation.row(i).end(), before.allocation.row(i).begin()) ||
+         !equal(x.need.row(i).begin(), x.need.row(i).end(), before.need.row(i).begin()))
+        failure += "admission changed the state\n";
+    }
+    if(x.available != before.available)
+      failure += "admission changed the available vector\n";
+
+    if(!failure.empty())
+    {
+      failures++;
+      write_text("verify_failure.txt", x, n, m);
+      cout << "Round " << rounds << ", n = " << n << ", m = " << m << ", process " << cur_proc + 1
+           << ": reference gave " << (verdicts[0] ? "safe " : "unsafe ") << routes[0] << "\n" << failure
+           << "State written to verify_failure.txt" << endl;
+      break;
+    }
+  }
+
+  cout << rounds << " states, " << failures << " failures\n";
+  for(int e = 0; e < 6; e++)
+  {
+    cout << engines[e] << ": " << engine_calls[e] << " checks, "
+         << (engine_s[e] > 0 ? engine_calls[e] / engine_s[e] : 0.0) << " per second" << endl;
+  }
+  cout << endl;
+  return failures == 0;
+}
+
+int main(int argc, char** argv)
+{
+  /* A fixed seed so runs can be compared against each other */
+  mt19937 gen(4348);
+  string mode = argc > 1 ? argv[1] : "";
+  //Built with -Dbank_metrics, print the counters and timers at exit (see metrics.h).
+  metrics_at_exit();
+
+  if(mode == "threads")
+  {
+    bench_threads(gen, argc > 2 ? atoi(argv[2]) : 5000, argc > 3 ? atoi(argv[3]) : 128);
+    return 0;
+  }
+  if(mode == "verify")
+  {
+    return bench_verify(gen, argc > 2 ? atof(argv[2]) : 10) ? 0 : 1;
+  }
+  if(mode == "decision")
+  {
+    bench_decision(gen, argc > 2 ? atoi(argv[2]) : 20000, argc > 3 ? atoi(argv[3]) : 16);
+    return 0;
+  }
+  if(mode == "sequences")
+  {
+    bench_sequences(gen, argc > 2 ? atoi(argv[2]) : 24, argc > 3 ? atoi(argv[3]) : 4);
+    return 0;
+  }
+  if(mode == "fixed")
+  {
+    bench_fixed(gen, argc > 2 ? atoi(argv[2]) : 100000);
+    return 0;
+  }
+  if(mode == "cache")
+  {
+    bench_cache(gen, argc > 2 ? atoi(argv[2]) : 2000, argc > 3 ? atoi(argv[3]) : 64);
+    return 0;
+  }
+  if(mode == "pools")
+  {
+    bench_pools(gen, argc > 2 ? atoi(argv[2]) : 2000);
+    return 0;
+  }
+  if(mode == "alloc")
+  {
+#ifdef bench_heap
+    bench_alloc(gen, argc > 2 ? atoi(argv[2]) : 2000, argc > 3 ? atoi(argv[3]) : 64);
+    return 0;
+#else
+    cerr << "bench alloc needs the program built with -Dbench_heap" << endl;
+    return 1;
+#endif
+  }
+  if(mode == "suite")
+  {
+    bench_suite(gen, argc > 2 ? argv[2] : "data.csv");
+    return 0;
+  }
+  if(mode == "detect")
+  {
+    bench_detect(gen, argc > 2 ? atoi(argv[2]) : 100000, argc > 3 ? atoi(argv[3]) : 8);
+    return 0;
+  }
+  if(mode == "parse")
+  {
+    bench_parse(gen, argc > 2 ? atoi(argv[2]) : 50000, argc > 3 ? atoi(argv[3]) : 256);
+    return 0;
+  }
+
+  bench_kernels(gen);
+  bench_checkers(gen);
+
+  return 0;
+}
@@ -0,0 +1,355 @@
+/********************************************
+File Name: 			cache.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Classes:
+	 state_fingerprint - A 64 bit hash of the available vector and the need and allocation
+	                     rows of a state, updated one row at a time.
+
+	 safe_cache - Remembers the answer of the safety check for the states it has seen,
+	              keyed by their fingerprint, within a fixed amount of memory.
+
+Cache file format (all values native endian int32):
+	 header - 'B' 'K' 'S' 'C', version, number of entries.
+	 entry  - the fingerprint, low half first, 1 if the state was safe, the length of
+	          the sequence and the sequence, least recently used entry first.
+
+Procedures: Members of the state_fingerprint class.
+
+void reset(const state& s, int n, int m)
+    - Hash the whole of s.
+
+void update_row(int i, const state& s, int m), void drop_row(int i)
+    - Hash row i again after it changed, or leave it out of the hash.
+
+void update_available(const vector<int>& available, int m)
+    - Hash the available vector again after it changed.
+
+Procedures: Members of the safe_cache class.
+
+const cache_entry* find(uint64_t key)
+    - The answer stored for a state, NULL if there is none.
+
+void insert(uint64_t key, bool safe, const vector<int>& sequence)
+    - Store the answer for a state, evicting the least recently used ones to make room.
+
+bool save(const char* path) const, bool load(const char* path)
+    - Write the entries to a cache file, or read them back from one.
+********************************************/
+
+#ifndef cache_h
+#define cache_h
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "header.h"
+
+using namespace std;
+
+/* Cache file header, the magic number and version */
+#define cache_magic "BKSC"
+#define cache_version 1
+
+/********************************************
+Procedure Name: mix64()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - x = the value to be mixed.
+
+Description:
+	The finaliser of splitmix64, every bit of the result depends on every bit of x.
+********************************************/
+inline uint64_t mix64(uint64_t x)
+{
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+/********************************************
+Class Name: 		    state_fingerprint
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Every row i hashes its number and its need and allocation values into one 64 bit
+        word, and so does the available vector. The fingerprint is the sum of all of
+        them, so when a row changes its old word is taken off and the new one added,
+        O(m). The allocation matrix has to be part of it along with the need matrix, as
+        it decides what a process gives back when it finishes. Two different states
+        share a fingerprint with a probability of about 2^-64.
+********************************************/
+class state_fingerprint
+{
+private:
+  //the word of every row, 0 for rows left out
+  vector<uint64_t> rows;
+  //the word of the available vector
+  uint64_t avail;
+  //the sum of all the words
+  uint64_t sum;
+
+  static uint64_t hash_row(int i, const state& s, int m)
+  {
+    row_view need = s.need.row(i);
+    row_view allocation = s.allocation.row(i);
+    uint64_t h = mix64(0x9e3779b97f4a7c15ULL + i);
+    for(int j = 0; j < m; j++)
+    {
+      h = mix64(h ^ ((uint64_t)(uint32_t)need[j] | (uint64_t)(uint32_t)allocation[j] << 32));
+    }
+    return h;
+  }
+
+public:
+  state_fingerprint() : avail(0), sum(0) {}
+
+  void reset(const state& s, int n, int m)
+  {
+    rows.assign(n, 0);
+    sum = 0;
+    for(int i = 0; i < n; i++)
+    {
+      rows[i] = hash_row(i, s, m);
+      sum += rows[i];
+    }
+    avail = 0;
+    update_available(s.available, m);
+  }
+
+  void update_row(int i, const state& s, int m)
+  {
+    if(i >= (int)rows.size())
+      rows.resize(i + 1, 0);
+    sum -= rows[i];
+    rows[i] = hash_row(i, s, m);
+    sum += rows[i];
+  }
+
+  void drop_row(int i)
+  {
+    sum -= rows[i];
+    rows[i] = 0;
+  }
+
+  void update_available(const vector<int>& available, int m)
+  {
+    sum -= avail;
+    avail = mix64(0x243f6a8885a308d3ULL);
+    for(int j = 0; j < m; j++)
+    {
+      avail = mix64(avail ^ (uint32_t)available[j]);
+    }
+    sum += avail;
+  }
+
+  uint64_t value() const { return sum; }
+};
+
+/********************************************
+Structure Name: 		cache_entry
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        The answer of the safety check for one state.
+********************************************/
+struct cache_entry
+{
+  //the fingerprint of the state
+  uint64_t key;
+  //whether the state was safe
+  bool safe;
+  //the processes in the order the check ran them
+  vector<int> sequence;
+};
+
+/********************************************
+Class Name: 		    safe_cache
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        The answers of the safety check keyed by the fingerprint of the state. The
+        entries are kept on a list, most recently used first, with a hash table from
+        the fingerprint to its place on the list, so a lookup, an insert and moving an
+        entry to the front are all O(1). Every entry is charged for its sequence and
+        roughly what the list and table spend on it, and the least recently used ones
+        are evicted while the total is over the budget.
+
+        The entries can be written to a file and read back by a later run, so the states
+        a service has answered before are answered from the start. A fingerprint is made
+        from the rows of the state alone, so a file written for one input does no harm
+        with another, its entries are just never found.
+********************************************/
+class safe_cache
+{
+private:
+  //entries, most recently used first
+  list<cache_entry> entries;
+  //where each fingerprint is on the list
+  unordered_map<uint64_t, list<cache_entry>::iterator> index;
+  //the most bytes the entries may take, and what they take now
+  size_t budget;
+  size_t used;
+
+  static size_t cost(const cache_entry& e)
+  {
+    //The list node, the table node and its bucket, and the sequence.
+    return sizeof(cache_entry) + 64 + e.sequence.capacity() * sizeof(int);
+  }
+
+public:
+  //number of lookups that found an entry or didn't, and of entries evicted
+  long hits, misses, evictions;
+
+  safe_cache(size_t bytes) : budget(bytes), used(0), hits(0), misses(0), evictions(0) {}
+
+  bool enabled() const { return budget > 0; }
+  size_t size() const { return entries.size(); }
+  size_t bytes() const { return used; }
+
+  const cache_entry* find(uint64_t key)
+  {
+    unordered_map<uint64_t, list<cache_entry>::iterator>::iterator it = index.find(key);
+    if(it == index.end())
+    {
+      misses++;
+      return NULL;
+    }
+    hits++;
+    entries.splice(entries.begin(), entries, it->second);
+    return &entries.front();
+  }
+
+  void insert(uint64_t key, bool safe, const vector<int>& sequence)
+  {
+    unordered_map<uint64_t, list<cache_entry>::iterator>::iterator it = index.find(key);
+    if(it != index.end())
+    {
+      used -= cost(*it->second);
+      entries.erase(it->second);
+      index.erase(it);
+    }
+
+    cache_entry e = {key, safe, sequence};
+    if(cost(e) > budget)
+      return;
+    entries.push_front(e);
+    index[key] = entries.begin();
+    used += cost(entries.front());
+
+    //Evict from the back until the budget is met again.
+    while(used > budget)
+    {
+      used -= cost(entries.back());
+      index.erase(entries.back().key);
+      entries.pop_back();
+      evictions++;
+    }
+  }
+
+  bool save(const char* path) const;
+  bool load(const char* path);
+};
+
+/********************************************
+Procedure Name: save()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the cache file to be written.
+
+Description:
+	Write every entry out in the cache file format, least recently used first, so that
+  reading them back in order leaves them in the same order. Returns false if the file
+  can't be written.
+********************************************/
+bool safe_cache::save(const char* path) const
+{
+  FILE* out = fopen(path, "wb");
+  if(out == NULL)
+    return false;
+
+  int header[3] = {0, cache_version, (int)entries.size()};
+  memcpy(header, cache_magic, 4);
+  fwrite(header, sizeof(int), 3, out);
+  for(list<cache_entry>::const_reverse_iterator e = entries.rbegin(); e != entries.rend(); ++e)
+  {
+    int head[4] = {(int)(uint32_t)e->key, (int)(uint32_t)(e->key >> 32), e->safe, (int)e->sequence.size()};
+    fwrite(head, sizeof(int), 4, out);
+    fwrite(e->sequence.data(), sizeof(int), e->sequence.size(), out);
+  }
+
+  bool ok = !ferror(out);
+  return fclose(out) == 0 && ok;
+}
+
+/********************************************
+Procedure Name: load()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the cache file to be read.
+
+Description:
+	Read the entries of a cache file in, evicting as insert() does if they don't fit in
+  the budget. Returns false, with the cache left empty, if the file can't be read, isn't
+  a cache file or is cut short.
+********************************************/
+bool safe_cache::load(const char* path)
+{
+  FILE* in = fopen(path, "rb");
+  if(in == NULL)
+    return false;
+
+  int header[3];
+  bool ok = fread(header, sizeof(int), 3, in) == 3 && memcmp(header, cache_magic, 4) == 0
+    && header[1] == cache_version && header[2] >= 0;
+  vector<int> sequence;
+  for(int k = 0; ok && k < header[2]; k++)
+  {
+    int head[4];
+    ok = fread(head, sizeof(int), 4, in) == 4 && head[3] >= 0;
+    if(!ok)
+      break;
+    //Read the sequence in blocks, so a bad length runs into the end of the file first.
+    sequence.clear();
+    int block[1024];
+    for(int left = head[3]; ok && left > 0; left -= 1024)
+    {
+      size_t want = min(left, 1024);
+      ok = fread(block, sizeof(int), want, in) == want;
+      sequence.insert(sequence.end(), block, block + want);
+    }
+    if(ok)
+      insert((uint64_t)(uint32_t)head[0] | (uint64_t)(uint32_t)head[1] << 32, head[2] != 0, sequence);
+  }
+  fclose(in);
+
+  if(!ok)
+  {
+    entries.clear();
+    index.clear();
+    used = 0;
+  }
+  return ok;
+}
+
+#endif /* cache_h */
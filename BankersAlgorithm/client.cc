@@ -0,0 +1,195 @@
+/********************************************
+File Name: 			client.cc
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Procedures:
+
+	main() : A load generator for the admission service (see service.h). Connects to the
+  service's Unix domain socket, sends a stream of random events one at a time and reports
+  the p50 and p99 time from sending an event to getting its answer.
+
+  Usage: client socket_path [events] [seed]
+
+	connect_to() : Connect to the Unix domain socket at a path.
+
+	ask() : Send one event line and wait for the answer line.
+
+********************************************/
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <string.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/********************************************
+Procedure Name: connect_to()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the path of the socket.
+
+Description:
+	Connect to the Unix domain socket at path. Returns the socket, or -1 on failure.
+********************************************/
+int connect_to(const char* path)
+{
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if(fd < 0)
+    return -1;
+  sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  if(connect(fd, (sockaddr*)&addr, sizeof(addr)) < 0)
+  {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/********************************************
+Procedure Name: ask()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - fd = the connected socket.
+  - event = the event line, ending in a newline.
+  - answer = where the answer line is stored, without the newline.
+
+Description:
+	Send one event and wait for the answer. Returns false if the connection is lost.
+********************************************/
+bool ask(int fd, const string& event, string& answer)
+{
+  size_t sent = 0;
+  while(sent < event.size())
+  {
+    ssize_t w = write(fd, event.data() + sent, event.size() - sent);
+    if(w <= 0)
+      return false;
+    sent += w;
+  }
+
+  //The service answers every line with exactly one line.
+  answer.clear();
+  char c;
+  while(true)
+  {
+    if(read(fd, &c, 1) != 1)
+      return false;
+    if(c == '\n')
+      return true;
+    answer += c;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  if(argc < 2)
+  {
+    cerr << "Usage: " << argv[0] << " socket_path [events] [seed]\n";
+    return 1;
+  }
+  int events = argc > 2 ? atoi(argv[2]) : 100000;
+  mt19937 gen(argc > 3 ? atoi(argv[3]) : 4348);
+
+  int fd = connect_to(argv[1]);
+  if(fd < 0)
+  {
+    cerr << "Could not connect to " << argv[1] << endl;
+    return 1;
+  }
+
+  //Find out how many processes and resources the service has.
+  string answer;
+  int slots = 0, m = 0;
+  if(!ask(fd, "info\n", answer) || sscanf(answer.c_str(), "INFO %d %d", &slots, &m) != 2 || m <= 0)
+  {
+    cerr << "Unexpected answer to info: " << answer << endl;
+    return 1;
+  }
+
+  /*
+    Mostly small requests and releases by random processes, with the odd process leaving
+    and a new one coming in. Some of the events will be for processes that have left, those
+    are answered with an error and are timed like any other event.
+  */
+  uniform_int_distribution<int> kind(0, 99);
+  uniform_int_distribution<int> units(0, 1);
+  vector<double> latency;
+  latency.reserve(events);
+  long grants = 0, denies = 0, errors = 0;
+  string event;
+
+  chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+  for(int e = 0; e < events; e++)
+  {
+    int k = kind(gen);
+    int p = uniform_int_distribution<int>(1, max(slots, 1))(gen);
+    event.clear();
+    if(k < 60)
+    {
+      event = "request " + to_string(p);
+      for(int j = 0; j < m; j++)
+        event += " " + to_string(units(gen));
+    }
+    else if(k < 95)
+    {
+      event = "release " + to_string(p);
+    }
+    else if(k < 98)
+    {
+      event = "exit " + to_string(p);
+    }
+    else
+    {
+      event = "new";
+      for(int j = 0; j < m; j++)
+        event += " " + to_string(units(gen) + units(gen));
+    }
+    event += "\n";
+
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    if(!ask(fd, event, answer))
+    {
+      cerr << "Connection lost after " << e << " events\n";
+      break;
+    }
+    latency.push_back(chrono::duration<double, micro>(chrono::steady_clock::now() - start).count());
+
+    if(answer.compare(0, 5, "GRANT") == 0)
+    {
+      grants++;
+      //Keep track of the highest process number handed out.
+      int q;
+      if(sscanf(answer.c_str(), "GRANT %d", &q) == 1 && q > slots)
+        slots = q;
+    }
+    else if(answer.compare(0, 4, "DENY") == 0)
+      denies++;
+    else if(answer.compare(0, 5, "ERROR") == 0)
+      errors++;
+  }
+  double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+  close(fd);
+
+  if(latency.empty())
+    return 1;
+  sort(latency.begin(), latency.end());
+  cout << "Events: " << latency.size() << " (" << grants << " granted, " << denies << " denied, "
+       << errors << " errors)\n"
+       << "Throughput: " << latency.size() / seconds << " events/s\n"
+       << "Decision latency p50 = " << latency[latency.size() / 2] << " us, p99 = "
+       << latency[min(latency.size() - 1, latency.size() * 99 / 100)] << " us\n";
+  return 0;
+}
@@ -0,0 +1,281 @@
+/********************************************
+File Name: 			decision.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Struct:
+	 decision - The outcome of the admission loop as numbers: the process granted, its
+	            safe sequence, the available vector after every step of it, and the
+	            processes in error and suspended on the way.
+
+Classes:
+	 record_sink - The sink of admission_loop() (see header.h) that fills in a decision.
+
+	 record_writer - Writes decisions as JSON Lines or binary records through one
+	                 reused buffer.
+
+Procedures:
+
+bool record_check(struct state* s, int m, int cur_proc, const vector<int>& suspended, const vector<int>& processes, decision& d, workspace<adaptive_checker>& w)
+    - The safety check of run_safe(), storing its steps in d.
+
+bool decide(struct state* info, int n, int m, decision& d, workspace<adaptive_checker>& w)
+    - admission_loop() with a record_sink, filling in d instead of printing a route.
+
+Procedures: Members of the record_writer class.
+
+void jsonl(const decision& d, int m)
+    - Write d as one line of JSON.
+
+void binary(const decision& d, int m)
+    - Write d as a binary record.
+
+Binary record, all fields 32 bit ints in the byte order of the machine:
+    "BKDR", process, m, length of sequence, of denied and of suspended,
+    sequence, available after every step (length of sequence rows of m), denied,
+    suspended.
+
+Processes are numbered from 1 in both formats, as in the text output, and process
+is 0 when no request could be granted.
+********************************************/
+
+#ifndef decision_h
+#define decision_h
+
+#include <stdio.h>
+#include <string.h>
+#include <charconv>
+#include <vector>
+
+#include "header.h"
+
+using namespace std;
+
+/********************************************
+Structure Name: 		decision
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        What the admission loop decided. The vectors are cleared and refilled by
+        decide(), so one decision kept by the caller stops allocating once it has
+        grown to the size of the state.
+********************************************/
+struct decision
+{
+  //the process whose request was granted, -1 if none could be
+  int process;
+  //the safe sequence found for it, or the processes the last check could run
+  vector<int> sequence;
+  //the available vector after each process of the sequence finished, one row of m each
+  vector<int> available;
+  //processes whose request is more than their claim
+  vector<int> denied;
+  //processes whose request was more than available or left the state unsafe
+  vector<int> suspended;
+};
+
+/********************************************
+Procedure Name: record_check()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - s = the state, with the request of cur_proc granted.
+  - m = number of resources.
+  - cur_proc, suspended, processes = as for safe().
+  - d = where the sequence and available vectors are stored.
+  - w = the scratch space of the check.
+
+Description:
+	The safety check of run_safe() with every step stored in d as numbers, with no
+  tracer and no route string. Returns true if the state is safe.
+********************************************/
+bool record_check(struct state* s, int m, int cur_proc, const vector<int>& suspended, const vector<int>& processes, decision& d, workspace<adaptive_checker>& w)
+{
+  count_metric(metric_safe_calls, 1);
+  time_phase(phase_check);
+
+  vector<int>& rest = w.rest;
+  rest.clear();
+  rest.push_back(cur_proc);
+  rest.insert(rest.end(), suspended.begin(), suspended.end());
+  rest.insert(rest.end(), processes.begin(), processes.end());
+
+  adaptive_checker& c = w.c;
+  c.start(s->need, s->allocation, s->available, rest, m);
+  d.sequence.clear();
+  d.available.clear();
+  int p;
+  while((p = c.next()) != -1)
+  {
+    d.sequence.push_back(p);
+    d.available.insert(d.available.end(), c.current_available().begin(), c.current_available().begin() + m);
+  }
+  return c.remaining() == 0;
+}
+
+/********************************************
+Class Name: 		    record_sink
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        The sink of admission_loop() for decision records. Every check is made by
+        record_check() into d, the processes in error go to d.denied and the one
+        granted to d.process. The loop puts the suspended processes in d.suspended
+        itself. The JSON Lines and binary records are both written from d by
+        record_writer.
+********************************************/
+class record_sink
+{
+private:
+  //number of resources
+  int m;
+  //the decision being filled in
+  decision& d;
+  //the scratch space shared by all the checks
+  workspace<adaptive_checker>& w;
+
+public:
+  record_sink(int m, decision& d, workspace<adaptive_checker>& w) : m(m), d(d), w(w) {}
+
+  void error(int p) { d.denied.push_back(p); }
+
+  bool check(struct state* s, int p, const vector<int>& suspended, const vector<int>& processes)
+  {
+    return record_check(s, m, p, suspended, processes, d, w);
+  }
+
+  void unsafe(int) {}
+  void grant(int p) { d.process = p; }
+};
+
+/********************************************
+Procedure Name: decide()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - info = the state read in.
+  - n & m = number of processes and resources.
+  - d = where the decision is stored.
+  - w = the scratch space of the checks.
+
+Description:
+	admission_loop() with a record_sink, taking the processes in the same order as admit()
+  and granting the same one. Instead of a route string it leaves the outcome in d.
+********************************************/
+bool decide(struct state* info, int n, int m, decision& d, workspace<adaptive_checker>& w)
+{
+  time_phase(phase_admit);
+  d.process = -1;
+  d.denied.clear();
+  d.suspended.clear();
+  d.sequence.clear();
+  d.available.clear();
+  record_sink out(m, d, w);
+  return admission_loop(info, n, m, d.suspended, out);
+}
+
+/********************************************
+Class Name: 		    record_writer
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Serialises decisions to a FILE. A record is put together in a buffer kept
+        between records, numbers are written with to_chars and the buffer goes out in
+        one fwrite, so no strings are built.
+********************************************/
+class record_writer
+{
+private:
+  //where the records go
+  FILE* out;
+  //the record being put together
+  vector<char> buf;
+
+  void put(const char* s, size_t len) { buf.insert(buf.end(), s, s + len); }
+  void put(const char* s) { put(s, strlen(s)); }
+
+  void put_int(int x)
+  {
+    char digits[12];
+    to_chars_result r = to_chars(digits, digits + sizeof(digits), x);
+    put(digits, r.ptr - digits);
+  }
+
+  //A JSON array of the ints in [first, last), each plus add.
+  void put_array(const int* first, const int* last, int add)
+  {
+    buf.push_back('[');
+    for(const int* it = first; it != last; ++it)
+    {
+      if(it != first)
+        buf.push_back(',');
+      put_int(*it + add);
+    }
+    buf.push_back(']');
+  }
+
+  void put_raw(const int* ints, size_t count) { put((const char*)ints, count * sizeof(int)); }
+
+  //The processes of v as raw ints, numbered from 1.
+  void put_processes(const vector<int>& v)
+  {
+    for(size_t i = 0; i < v.size(); i++)
+    {
+      int p = v[i] + 1;
+      put_raw(&p, 1);
+    }
+  }
+
+public:
+  record_writer(FILE* f) : out(f) {}
+
+  void jsonl(const decision& d, int m)
+  {
+    buf.clear();
+    put("{\"process\":");
+    put_int(d.process + 1);
+    put(",\"safe\":");
+    put(d.process >= 0 ? "true" : "false");
+    put(",\"sequence\":");
+    put_array(d.sequence.data(), d.sequence.data() + d.sequence.size(), 1);
+    put(",\"available\":[");
+    for(size_t k = 0; k < d.sequence.size(); k++)
+    {
+      if(k > 0)
+        buf.push_back(',');
+      put_array(d.available.data() + k * m, d.available.data() + (k + 1) * m, 0);
+    }
+    put("],\"denied\":");
+    put_array(d.denied.data(), d.denied.data() + d.denied.size(), 1);
+    put(",\"suspended\":");
+    put_array(d.suspended.data(), d.suspended.data() + d.suspended.size(), 1);
+    put("}\n");
+    fwrite(buf.data(), 1, buf.size(), out);
+  }
+
+  void binary(const decision& d, int m)
+  {
+    buf.clear();
+    int header[6] = {0, d.process + 1, m, (int)d.sequence.size(), (int)d.denied.size(), (int)d.suspended.size()};
+    memcpy(header, "BKDR", 4);
+    put_raw(header, 6);
+    put_processes(d.sequence);
+    put_raw(d.available.data(), d.available.size());
+    put_processes(d.denied);
+    put_processes(d.suspended);
+    fwrite(buf.data(), 1, buf.size(), out);
+  }
+
+  void flush() { fflush(out); }
+};
+
+#endif /* decision_h */
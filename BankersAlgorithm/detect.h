@@ -0,0 +1,624 @@
+/********************************************
+File Name: 			detect.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Classes:
+	 deadlock_detector - Finds the deadlocked processes of a state from its allocation and
+	                     request matrices, with any number of units of every resource.
+
+	 wait_for_graph - Finds the deadlocked processes when every resource has a single unit,
+	                  from the cycles of the graph of which process waits for which.
+
+Both are detection rather than avoidance: claims aren't needed, a process is deadlocked if
+its outstanding request can never be met. Processes holding nothing are never reported,
+they block no one. Changes are recorded as they happen and the next detection only
+redoes the work they affect.
+
+Procedures: Members of the deadlock_detector class.
+
+deadlock_detector(const state& s, int n, int m)
+    - Detect on the allocation and request matrices and the available vector of s.
+
+void update(int p, const int* allocation, const int* request)
+    - Process p now holds allocation and asks for request, the available vector follows.
+
+const vector<int>& detect()
+    - The deadlocked processes, in increasing order.
+
+Procedures: Members of the wait_for_graph class.
+
+wait_for_graph(int n, int m), wait_for_graph(const state& s, int n, int m)
+    - An empty graph, or the graph of the single unit resources of s.
+
+bool acquire(int p, int r), bool release(int p, int r)
+    - Process p takes free resource r or gives it back.
+
+void wait(int p, int r), void cancel(int p, int r)
+    - Process p starts or stops waiting for resource r.
+
+const vector<int>& detect()
+    - The deadlocked processes, in increasing order.
+********************************************/
+
+#ifndef detect_h
+#define detect_h
+
+#include <vector>
+#include <algorithm>
+
+#include "header.h"
+
+using namespace std;
+
+/* Where a process stands after the last detection in deadlock_detector */
+#define detect_idle 0
+#define detect_finished 1
+#define detect_queued 2
+#define detect_stuck 3
+
+/********************************************
+Class Name: 		    deadlock_detector
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        The detection algorithm for resources with several units. Starting from the
+        available vector, any process whose request can be met is taken to finish and
+        give back what it holds, until none is left that can. The processes left over
+        are deadlocked. Finishing a process never stops another from finishing, so the
+        set left over doesn't depend on the order the processes are taken in.
+
+        That is what makes it incremental. The order the processes finished in last time
+        is kept, and the next detection first walks it once, O(n * m), keeping every
+        process that can still finish at its turn. Only the ones that can't, the ones
+        deadlocked last time and the ones that have started holding something since are
+        left to the incremental checker of safety.h, with their requests in place of
+        the need matrix.
+********************************************/
+class deadlock_detector
+{
+private:
+  //number of processes and resources
+  int n, m;
+  //what every process holds and is waiting for
+  matrix allocation, request;
+  //vector of available resources
+  vector<int> available;
+  //1 if the process holds anything
+  vector<char> holding;
+  //detect_idle, detect_finished or detect_stuck for every process
+  vector<char> status;
+  //the processes that finished in the last detection, in the order they did
+  vector<int> sequence;
+  //the processes found deadlocked in the last detection
+  vector<int> deadlocked;
+  //the processes updated since the last detection, and whether there are any
+  vector<int> changed;
+  bool dirty;
+  //buffers kept between detections
+  vector<int> rest, kept;
+  incremental_checker checker;
+
+public:
+  deadlock_detector(const state& s, int procs, int res);
+
+  void update(int p, const int* alloc, const int* req);
+
+  const vector<int>& detect();
+};
+
+/********************************************
+Procedure Name: deadlock_detector()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - s = the state whose allocation and request matrices are detected on.
+  - procs & res = number of processes and resources.
+
+Description:
+	The constructor for the deadlock_detector class. The matrices of s are shared until
+  the first update.
+********************************************/
+deadlock_detector::deadlock_detector(const state& s, int procs, int res)
+  : n(procs), m(res), allocation(s.allocation), request(s.request), available(s.available),
+    holding(procs, 0), status(procs, detect_idle), dirty(true)
+{
+  for(int p = 0; p < n; p++)
+  {
+    row_view a = allocation.row(p);
+    holding[p] = any_of(a.begin(), a.end(), [](int x) { return x != 0; });
+    if(holding[p])
+      changed.push_back(p);
+  }
+}
+
+/********************************************
+Procedure Name: update()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process that changed.
+  - alloc = the m units it now holds.
+  - req = the m units it is now waiting for.
+
+Description:
+	Record that process p now holds alloc and waits for req. What it took or gave back
+  is taken from or added to the available vector.
+********************************************/
+void deadlock_detector::update(int p, const int* alloc, const int* req)
+{
+  int* a = allocation.mutable_row(p);
+  int* r = request.mutable_row(p);
+  bool any = false;
+  for(int j = 0; j < m; j++)
+  {
+    available[j] -= alloc[j] - a[j];
+    a[j] = alloc[j];
+    r[j] = req[j];
+    any = any || alloc[j] != 0;
+  }
+  holding[p] = any;
+  changed.push_back(p);
+  dirty = true;
+}
+
+/********************************************
+Procedure Name: detect()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	None.
+
+Description:
+	Find the deadlocked processes. Walks the order from the last detection, then runs the
+  incremental checker over whatever couldn't finish in it. Returns the last answer
+  straight away if nothing was updated since.
+********************************************/
+const vector<int>& deadlock_detector::detect()
+{
+  if(!dirty)
+    return deadlocked;
+
+  //Walk the old order, keeping every process that can still finish when it comes up.
+  vector<int> work = available;
+  rest.clear();
+  kept.clear();
+  for(size_t k = 0; k < sequence.size(); k++)
+  {
+    int p = sequence[k];
+    if(!holding[p])
+    {
+      status[p] = detect_idle;
+    }
+    else if(row_le(request.row(p).data, work.data(), m))
+    {
+      row_view a = allocation.row(p);
+      for(int j = 0; j < m; j++)
+      {
+        work[j] += a[j];
+      }
+      kept.push_back(p);
+    }
+    else
+    {
+      status[p] = detect_queued;
+      rest.push_back(p);
+    }
+  }
+  sequence.swap(kept);
+
+  //Add the ones that were deadlocked and the ones that have started holding something.
+  for(size_t k = 0; k < deadlocked.size(); k++)
+  {
+    int p = deadlocked[k];
+    status[p] = holding[p] ? detect_queued : detect_idle;
+    if(holding[p])
+      rest.push_back(p);
+  }
+  for(size_t k = 0; k < changed.size(); k++)
+  {
+    int p = changed[k];
+    if(status[p] == detect_idle && holding[p])
+    {
+      status[p] = detect_queued;
+      rest.push_back(p);
+    }
+  }
+  changed.clear();
+
+  //Reduce the rest with the request matrix standing in for the need matrix.
+  checker.start(request, allocation, work, rest, m);
+  int p;
+  while((p = checker.next()) != -1)
+  {
+    status[p] = detect_finished;
+    sequence.push_back(p);
+  }
+
+  deadlocked.clear();
+  for(size_t k = 0; k < rest.size(); k++)
+  {
+    if(status[rest[k]] == detect_queued)
+    {
+      status[rest[k]] = detect_stuck;
+      deadlocked.push_back(rest[k]);
+    }
+  }
+  sort(deadlocked.begin(), deadlocked.end());
+  dirty = false;
+  return deadlocked;
+}
+
+/********************************************
+Class Name: 		    wait_for_graph
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Detection for resources with a single unit each. Process p waits for process q
+        if p is waiting for a resource q holds. A process is deadlocked if it is on a
+        cycle of this graph or waits, directly or not, for one that is, and it holds
+        something. The strongly connected components are found with Tarjan's algorithm,
+        iteratively so that long chains don't run out of stack. Tarjan's algorithm
+        finishes a component only after every component it can reach, so whether it is
+        deadlocked is known as soon as it is finished.
+
+        Whether a process is deadlocked only depends on the processes it can reach. So a
+        detection only looks at the processes whose edges changed since the last one and
+        the processes that can reach them, found by walking the edges backwards. Edges
+        leaving that region go to processes whose answer is still good.
+********************************************/
+class wait_for_graph
+{
+private:
+  //number of processes and resources
+  int n, m;
+  //the process holding every resource, -1 if it is free
+  vector<int> holder;
+  //the resources every process holds and waits for
+  vector<vector<int>> held, wants;
+  //the processes waiting for every resource
+  vector<vector<int>> waiters;
+  //1 if the process is deadlocked
+  vector<char> stuck;
+  //the processes whose edges changed since the last detection
+  vector<int> changed;
+  //the deadlocked processes found by the last detection
+  vector<int> deadlocked;
+
+  //buffers for detect(): the region looked at and the stamp that marks it
+  vector<int> region, mark;
+  int stamp;
+  //Tarjan's numbering, lowest number reachable, and whether the process is on the stack
+  vector<int> index, low;
+  vector<char> on_stack;
+  //1 if the process has an edge to a deadlocked process or to itself
+  vector<char> reach;
+  //the component stack, and the process and next edge of every level of the walk
+  vector<int> component;
+  vector<pair<int, int>> calls;
+
+  //Remove x from v, the order of v doesn't matter.
+  static void erase_from(vector<int>& v, int x)
+  {
+    vector<int>::iterator it = find(v.begin(), v.end(), x);
+    if(it != v.end())
+    {
+      *it = v.back();
+      v.pop_back();
+    }
+  }
+
+  void strongconnect(int root, int& counter);
+
+public:
+  wait_for_graph(int procs, int res);
+  wait_for_graph(const state& s, int procs, int res);
+
+  bool acquire(int p, int r);
+  bool release(int p, int r);
+  void wait(int p, int r);
+  void cancel(int p, int r);
+
+  const vector<int>& detect();
+};
+
+/********************************************
+Procedure Name: wait_for_graph()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - procs & res = number of processes and resources.
+
+Description:
+	The constructor for the wait_for_graph class. No process holds or waits for anything.
+********************************************/
+wait_for_graph::wait_for_graph(int procs, int res)
+  : n(procs), m(res), holder(res, -1), held(procs), wants(procs), waiters(res),
+    stuck(procs, 0), mark(procs, 0), stamp(0), index(procs, -1), low(procs, 0),
+    on_stack(procs, 0), reach(procs, 0)
+{
+}
+
+/********************************************
+Procedure Name: wait_for_graph()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - s = the state whose allocation and request matrices give the edges.
+  - procs & res = number of processes and resources.
+
+Description:
+	The constructor for the wait_for_graph class from a state where every resource has a
+  single unit. A process holds the resources it has an allocation of and waits for the
+  ones it has a request for.
+********************************************/
+wait_for_graph::wait_for_graph(const state& s, int procs, int res)
+  : wait_for_graph(procs, res)
+{
+  for(int p = 0; p < n; p++)
+  {
+    row_view a = s.allocation.row(p);
+    for(int r = 0; r < m; r++)
+    {
+      if(a[r] > 0)
+        acquire(p, r);
+    }
+  }
+  for(int p = 0; p < n; p++)
+  {
+    row_view q = s.request.row(p);
+    for(int r = 0; r < m; r++)
+    {
+      if(q[r] > 0)
+        wait(p, r);
+    }
+  }
+}
+
+/********************************************
+Procedure Name: acquire()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process taking the resource.
+  - r = the resource, which has to be free.
+
+Description:
+	Process p takes resource r and stops waiting for it. Everyone waiting for r now waits
+  for p. Returns false if r is held already.
+********************************************/
+bool wait_for_graph::acquire(int p, int r)
+{
+  if(holder[r] != -1)
+    return false;
+  holder[r] = p;
+  held[p].push_back(r);
+  if(find(wants[p].begin(), wants[p].end(), r) != wants[p].end())
+    cancel(p, r);
+  changed.push_back(p);
+  changed.insert(changed.end(), waiters[r].begin(), waiters[r].end());
+  return true;
+}
+
+/********************************************
+Procedure Name: release()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process giving the resource back.
+  - r = the resource.
+
+Description:
+	Process p gives resource r back, no one waiting for it waits for p any more. Returns
+  false if p doesn't hold r.
+********************************************/
+bool wait_for_graph::release(int p, int r)
+{
+  if(holder[r] != p)
+    return false;
+  holder[r] = -1;
+  erase_from(held[p], r);
+  changed.push_back(p);
+  changed.insert(changed.end(), waiters[r].begin(), waiters[r].end());
+  return true;
+}
+
+/********************************************
+Procedure Name: wait()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process waiting.
+  - r = the resource it waits for.
+
+Description:
+	Process p starts waiting for resource r.
+********************************************/
+void wait_for_graph::wait(int p, int r)
+{
+  wants[p].push_back(r);
+  waiters[r].push_back(p);
+  changed.push_back(p);
+}
+
+/********************************************
+Procedure Name: cancel()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process waiting.
+  - r = the resource it no longer waits for.
+
+Description:
+	Process p stops waiting for resource r.
+********************************************/
+void wait_for_graph::cancel(int p, int r)
+{
+  erase_from(wants[p], r);
+  erase_from(waiters[r], p);
+  changed.push_back(p);
+}
+
+/********************************************
+Procedure Name: strongconnect()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - root = the process the walk starts from, in the region and not yet numbered.
+  - counter = the next number to be given out.
+
+Description:
+	Tarjan's walk from root over the processes in the region, with an explicit stack.
+  Every component is marked deadlocked as soon as it is finished: when it has more than
+  one process, or one of its processes waits for itself or for a process already known
+  to be deadlocked.
+********************************************/
+void wait_for_graph::strongconnect(int root, int& counter)
+{
+  index[root] = low[root] = counter++;
+  reach[root] = 0;
+  component.push_back(root);
+  on_stack[root] = 1;
+  calls.push_back(make_pair(root, 0));
+
+  while(!calls.empty())
+  {
+    int v = calls.back().first;
+    int e = calls.back().second;
+
+    //Follow the next edge of v.
+    if(e < (int)wants[v].size())
+    {
+      calls.back().second++;
+      int q = holder[wants[v][e]];
+      if(q < 0)
+        continue;
+      if(q == v)
+      {
+        reach[v] = 1;
+      }
+      else if(mark[q] != stamp)
+      {
+        //Outside the region, its answer from the last detection still holds.
+        if(stuck[q])
+          reach[v] = 1;
+      }
+      else if(index[q] == -1)
+      {
+        index[q] = low[q] = counter++;
+        reach[q] = 0;
+        component.push_back(q);
+        on_stack[q] = 1;
+        calls.push_back(make_pair(q, 0));
+      }
+      else if(on_stack[q])
+      {
+        low[v] = min(low[v], index[q]);
+      }
+      else if(stuck[q])
+      {
+        //q's component is finished already.
+        reach[v] = 1;
+      }
+      continue;
+    }
+
+    //Every edge of v has been followed, finish its component if it is the root of one.
+    calls.pop_back();
+    if(low[v] == index[v])
+    {
+      size_t start = find(component.rbegin(), component.rend(), v).base() - component.begin() - 1;
+      bool dead = component.size() - start > 1;
+      for(size_t k = start; k < component.size(); k++)
+      {
+        dead = dead || reach[component[k]];
+      }
+      for(size_t k = start; k < component.size(); k++)
+      {
+        int w = component[k];
+        on_stack[w] = 0;
+        stuck[w] = dead && !held[w].empty();
+      }
+      component.resize(start);
+    }
+    if(!calls.empty())
+    {
+      int u = calls.back().first;
+      low[u] = min(low[u], low[v]);
+      if(!on_stack[v] && stuck[v])
+        reach[u] = 1;
+    }
+  }
+}
+
+/********************************************
+Procedure Name: detect()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	None.
+
+Description:
+	Find the deadlocked processes. The region to be looked at again is every process
+  changed since the last detection and every process that waits on one of them, found
+  by walking from each process to the waiters of the resources it holds. Returns the
+  last answer straight away if nothing changed since.
+********************************************/
+const vector<int>& wait_for_graph::detect()
+{
+  if(changed.empty())
+    return deadlocked;
+
+  stamp++;
+  region.clear();
+  for(size_t k = 0; k < changed.size(); k++)
+  {
+    int p = changed[k];
+    if(mark[p] != stamp)
+    {
+      mark[p] = stamp;
+      region.push_back(p);
+    }
+  }
+  changed.clear();
+  for(size_t k = 0; k < region.size(); k++)
+  {
+    int v = region[k];
+    index[v] = -1;
+    for(size_t i = 0; i < held[v].size(); i++)
+    {
+      const vector<int>& w = waiters[held[v][i]];
+      for(size_t j = 0; j < w.size(); j++)
+      {
+        if(mark[w[j]] != stamp)
+        {
+          mark[w[j]] = stamp;
+          region.push_back(w[j]);
+        }
+      }
+    }
+  }
+
+  int counter = 0;
+  for(size_t k = 0; k < region.size(); k++)
+  {
+    if(index[region[k]] == -1)
+      strongconnect(region[k], counter);
+  }
+
+  deadlocked.clear();
+  for(int p = 0; p < n; p++)
+  {
+    if(stuck[p])
+      deadlocked.push_back(p);
+  }
+  return deadlocked;
+}
+
+#endif /* detect_h */
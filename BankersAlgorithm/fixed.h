@@ -0,0 +1,108 @@
+/********************************************
+File Name: 			fixed.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Classes:
+	 fixed_checker - The adaptive checker of safety.h with every loop over the resources
+	                 of a fixed length M.
+
+Procedures: The Banker's algorithm specialised for a fixed number of resources.
+
+bool safe_fixed(struct state* s, int n, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t, workspace<fixed_checker<M> >& w)
+    - safe() of header.h for M resources.
+
+bool admit_fixed(struct state* info, int n, string* route, tracer* t)
+    - admit() of header.h for M resources.
+
+bool admit_dispatch(struct state* info, int n, int m, string* route, tracer* t)
+    - Run the admission loop specialised for m if there is one, admit() otherwise.
+
+Nothing here is a second engine: the state, run_safe() and run_admit() are those of
+header.h, only the checker is instantiated for M.
+********************************************/
+
+#ifndef fixed_h
+#define fixed_h
+
+#include <vector>
+#include <string>
+
+#include "header.h"
+
+using namespace std;
+
+/* The checker of a fixed number of resources M. Its loops over the resources have a
+   constant trip count the compiler unrolls, and its rows are compared with
+   row_le_fixed<M> (see kernel.h). */
+template <int M>
+using fixed_checker = basic_adaptive_checker<M>;
+
+/********************************************
+Procedure Name: safe_fixed()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - s = the state which has the initial state, with M resources.
+  - n = number of processes.
+  - cur_proc = the process in question
+  - suspend = the vector of suspended processes
+  - processes = the vector of processes yet to be executed.
+  - route = a string to which the sequence of processes will be stored.
+  - t = the tracer the route and matrices are reported to (see trace.h).
+  - w = the scratch space of the check.
+Description:
+	run_safe() of header.h with the checker for M resources, giving the same result, route
+  and trace as safe().
+********************************************/
+template <int M>
+bool safe_fixed(struct state* s, int n, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t, workspace<fixed_checker<M> >& w)
+{
+  return run_safe(s, n, M, cur_proc, suspended, processes, route, t, w);
+}
+
+/********************************************
+Procedure Name: admit_fixed()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Same as admit_dispatch(), without m, which is M.
+
+Description:
+	run_admit() of header.h with the checker for M resources.
+********************************************/
+template <int M>
+bool admit_fixed(struct state* info, int n, string* route, tracer* t)
+{
+  workspace<fixed_checker<M> > w;
+  return run_admit(info, n, M, route, t, w);
+}
+
+/********************************************
+Procedure Name: admit_dispatch()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - info = the state read in.
+  - n & m = number of processes and resources.
+  - route = where the route found is stored.
+  - t = the tracer the output of the checks goes to.
+
+Description:
+	Run the admission loop specialised for m resources when there is one, 2, 3, 4, 6 or
+  8, and admit() for any other m. Either way the result, route and trace are the same.
+********************************************/
+bool admit_dispatch(struct state* info, int n, int m, string* route, tracer* t = &default_tracer)
+{
+  switch(m)
+  {
+    case 2: return admit_fixed<2>(info, n, route, t);
+    case 3: return admit_fixed<3>(info, n, route, t);
+    case 4: return admit_fixed<4>(info, n, route, t);
+    case 6: return admit_fixed<6>(info, n, route, t);
+    case 8: return admit_fixed<8>(info, n, route, t);
+  }
+  return admit(info, n, m, route, t);
+}
+
+#endif /* fixed_h */
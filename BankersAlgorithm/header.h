@@ -1,28 +1,56 @@
 /********************************************
 File Name: 			header.h
 Author: 				del_dilettante
-Last Modification Date: 10/18/2020
+Last Modification Date: 10/17/2026
 Last Modifier:          del_dilettante
 Struct:
 	 state - A structure to hold the resource and available vectors.
-           As well as the claim, allocation and the request matrices.
+           As well as the claim, allocation, request and need matrices, stored as flat
+           copy-on-write matrices (see matrix.h).
 
-Procedures: Helper methods for the main program.
+Class:
+	 route_sink - What the admission loop prints: the trace of every check and "Error State"
+	              for the processes in error, with the route of the one granted kept.
 
-void print_matrix(const char * str, vector<vector<int> > matrix, int n, int m)
-    - A helper method to print a matrix.
+Procedures: Helper methods for the main program.
 
-bool reqGTclaim(struct state &x, int cur_proc, int m)
+bool reqGTclaim(const struct state &x, int cur_proc, int m)
     - A method to check whether or not a process's request for all resources is more than its claims.
 
-bool reqGTavail(struct state &x, int cur_proc, int m)
+bool reqGTavail(const struct state &x, int cur_proc, int m)
     - A method to check whether or not a process's request for all resources is more than what is available.
 
-void state_copy(struct state* s1, state* s2, int m)
-    - A method to create a deep copy of a state struct object.
+void compute_need(struct state &x, int n, int m)
+    - A method to fill in the need matrix as claim - allocation.
+
+void state_copy(struct state* s1, state* s2)
+    - A method to create a copy-on-write snapshot of a state struct object.
+
+void state_grant(struct state* s1, const state* s2, int cur_proc, int m)
+    - A method to update a copy of a state as if the current request of a process was granted.
+
+void state_apply(struct state* s, int cur_proc, int sign, int m)
+    - A method to grant the current request of a process in place, or take it back.
+
+bool safe(struct state* s, int n, int m, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t, workspace<adaptive_checker>* w)
+	  - The method that implements the Banker's algorithm. Given a workspace kept between
+	    calls it makes no heap allocations.
 
-bool safe(struct state* s, int n, int m, int cur_proc, vector<int> suspended, vector<int> processes, string* route)
-	  - The method that implements the Banker's algorithm.
+bool safe_reference(struct state* s, int n, int m, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t)
+	  - The Banker's algorithm with the original O(n^2 * m) rescan, kept as a reference.
+
+bool safe_simd(struct state* s, int n, int m, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t)
+	  - The Banker's algorithm with the rescan done by the packed compare kernel.
+
+bool admission_loop(struct state* info, int n, int m, vector<int>& suspended, sink& out)
+	  - The admission loop: find the first process whose request can be granted safely,
+	    telling out what became of every process it takes.
+
+bool run_admit(struct state* info, int n, int m, string* route, tracer* t, workspace<checker>& w)
+	  - The admission loop with a route_sink, the safety checks made by any checker.
+
+bool admit(struct state* info, int n, int m, string* route, tracer* t)
+	  - The admission loop with the adaptive checker.
 ********************************************/
 
 #ifndef header_h
@@ -34,9 +62,20 @@ bool safe(struct state* s, int n, int m, int cur_proc, vector<int> suspended, ve
 #include <fstream>
 #include <string>
 #include <stdlib.h>
+#include <charconv>
+
+#include "matrix.h"
+#include "safety.h"
+#include "trace.h"
+#include "metrics.h"
 
 using namespace std;
 
+/* Answers to a request for resources */
+#define event_error -1
+#define event_deny 0
+#define event_grant 1
+
 /********************************************
 Structure Name: 		state
 Author: 				del_dilettante
@@ -55,91 +94,74 @@ struct state
   //vector of available resources
   vector<int> available;
   //matrix of resource claims by each process
-  vector<vector<int> > claim;
+  matrix claim;
   //matrix of resource allocation to each process
-  vector<vector<int> > allocation;
+  matrix allocation;
   //matrix of resource current request by each process
-  vector<vector<int> > request;
+  matrix request;
+  //matrix of what each process may still ask for, claim - allocation
+  matrix need;
 };
 
 /********************************************
-Procedure Name: print_matrix()
+Procedure Name: reqGTclaim()
 Author: 				del_dilettante
 Date: 					 10/18/2020
 Parameters:
-  - matrix = the 2d vector containing the matrix.
-  - m & n = dimensions of the matrix.
+  - x = const reference to the state struct/object.
+  - cur_proc = the process whose resource claim and requests are to be verified.
+  - m = the number of resources.
 
 Description:
-	A helper method to print a matrix.
+	A method to check whether or not a process's request for all resources is more than its claims.
+  allocation + request > claim is checked as request > need, a whole row at a time.
 ********************************************/
-void print_matrix(const char * str, vector<vector<int> > matrix, int n, int m)
+bool reqGTclaim(const struct state &x, int cur_proc, int m)
 {
-  cout << endl;
-  cout << str << "\n";
-  for(int i = 0; i < n; i++)
-  {
-      for (int j = 0; j < m; j++) {
-          cout << matrix[i][j] << " ";
-      }
-      cout << endl;
-  }
+  return !row_le(x.request.row(cur_proc).data, x.need.row(cur_proc).data, m);
 }
 
 /********************************************
-Procedure Name: reqGTclaim()
+Procedure Name: reqGTavail()
 Author: 				del_dilettante
-Date: 					 10/18/2020
+Date: 					10/18/2020
 Parameters:
-  - x = pass by reference copy of the state struct/object.
+  - x = const reference to the state struct/object.
   - cur_proc = the process whose resource claim and requests are to be verified.
   - m = the number of resources.
 
 Description:
-	A method to check whether or not a process's request for all resources is more than its claims.
+	A method to check whether or not a process's request for all resources is more than what is available.
 ********************************************/
-bool reqGTclaim(struct state &x, int cur_proc, int m)
+bool reqGTavail(const struct state &x, int cur_proc, int m)
 {
-  bool ret_val = false;
-
-  for(int i = 0; i < m; i++)
-  {
-    if(x.allocation[cur_proc][i] + x.request[cur_proc][i] > x.claim[cur_proc][i])
-    {
-      ret_val = true;
-      break;
-    }
-  }
-
-  return ret_val;
+  return !row_le(x.request.row(cur_proc).data, x.available.data(), m);
 }
 
 /********************************************
-Procedure Name: reqGTavail()
+Procedure Name: compute_need()
 Author: 				del_dilettante
-Date: 					10/18/2020
+Date: 					 10/17/2026
 Parameters:
-  - x = pass by reference copy of the state struct/object.
-  - cur_proc = the process whose resource claim and requests are to be verified.
-  - m = the number of resources.
+  - x = the state whose need matrix is to be filled in.
+  - n & m = number of processes and resources.
 
 Description:
-	A method to check whether or not a process's request for all resources is more than what is available.
+	A method to fill in the need matrix as claim - allocation.
 ********************************************/
-bool reqGTavail(struct state &x, int cur_proc, int m)
+void compute_need(struct state &x, int n, int m)
 {
-  bool ret_val = false;
-
-  for(int i = 0; i < m; i++)
+  x.need = matrix(n, m);
+  for(int i = 0; i < n; i++)
   {
-    if(x.request[cur_proc][i] > x.available[i])
+    row_view claim = x.claim.row(i);
+    row_view allocation = x.allocation.row(i);
+    int* need = x.need.mutable_row(i);
+    for(int j = 0; j < m; j++)
     {
-      ret_val = true;
-      break;
+      need[j] = claim[j] - allocation[j];
     }
   }
-
-  return ret_val;
 }
 
 /********************************************
@@ -149,30 +171,104 @@ Date: 					 10/18/2020
 Parameters:
   - s1 = the object where the copy is to be stored.
   - s2 = the object to be copied.
-  - m = the size of the second dimensions.
 
 Description:
-	A method to create a deep copy of a state struct object.
+	A method to create a copy of a state struct object. The resource and available vectors
+  are copied, the matrices are shared with s2 until either side writes to them, so the
+  copy costs O(m) rather than O(n*m).
 ********************************************/
-void state_copy(struct state* s1, state* s2, int m)
+void state_copy(struct state* s1, state* s2)
 {
   s1->resource = s2->resource;
   s1->available = s2->available;
   s1->claim = s2->claim;
   s1->allocation = s2->allocation;
   s1->request = s2->request;
+  s1->need = s2->need;
+}
+
+/********************************************
+Procedure Name: state_grant()
+Author: 				del_dilettante
+Date: 					 10/17/2026
+Parameters:
+  - s1 = a copy of s2 which is to be updated.
+  - s2 = the state the request is made in.
+  - cur_proc = the process whose request is granted.
+  - m = the number of resources.
+
+Description:
+	A method to update a copy of a state as if the current request of cur_proc was granted,
+  moving the request from the available vector to its allocation.
+********************************************/
+void state_grant(struct state* s1, const state* s2, int cur_proc, int m)
+{
+  row_view allocation = s2->allocation.row(cur_proc);
+  row_view request = s2->request.row(cur_proc);
+  row_view need = s2->need.row(cur_proc);
+  int* new_allocation = s1->allocation.mutable_row(cur_proc);
+  int* new_need = s1->need.mutable_row(cur_proc);
   for(int i = 0; i < m; i++)
   {
-    s1->claim[i] = s2->claim[i];
-    s1->allocation[i] = s2->allocation[i];
-    s1->request[i] = s2->request[i];
+      new_allocation[i] = allocation[i] + request[i];
+      new_need[i] = need[i] - request[i];
+      s1->available[i] = s2->available[i] - request[i];
   }
 }
 
 /********************************************
-Procedure Name: safe()
+Structure Name: 		workspace
 Author: 				del_dilettante
-Date: 					 10/18/2020
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        The scratch space of a safety check. It is kept by the caller and handed to every
+        check, which only clears and refills its buffers. Once they have grown to the
+        size of the state, a check with tracing off or at trace_route makes no heap
+        allocations at all.
+********************************************/
+template <class checker>
+struct workspace
+{
+  //the processes to be checked, the current one first
+  vector<int> rest;
+  //the checker, its buffers are reused from one check to the next
+  checker c;
+};
+
+/********************************************
+Procedure Name: state_apply()
+Author: 				del_dilettante
+Date: 					 10/17/2026
+Parameters:
+  - s = the state to be updated in place.
+  - cur_proc = the process whose request is granted.
+  - sign = 1 to grant the request, -1 to take it back.
+  - m = the number of resources.
+
+Description:
+	A method to grant the current request of a process in place, the same change
+  state_grant() makes to a copy. Granting and then taking back leaves s as it was.
+********************************************/
+void state_apply(struct state* s, int cur_proc, int sign, int m)
+{
+  row_view request = s->request.row(cur_proc);
+  int* allocation = s->allocation.mutable_row(cur_proc);
+  int* need = s->need.mutable_row(cur_proc);
+  for(int i = 0; i < m; i++)
+  {
+      allocation[i] += sign * request[i];
+      need[i] -= sign * request[i];
+      s->available[i] -= sign * request[i];
+  }
+}
+
+/********************************************
+Procedure Name: run_safe()
+Author: 				del_dilettante
+Date: 					 10/17/2026
 Parameters:
   - s = the state object which has the initial state.
   - n & m = number of processes and resources.
@@ -180,122 +276,307 @@ Parameters:
   - suspend = the vector of suspended processes
   - processes = the vector of processes yet to be executed.
   - route = a string to which the sequence of processes will be stored.
+  - t = the tracer the route and matrices are reported to (see trace.h).
+  - w = the scratch space of the check.
 Description:
-	The method that implements the Banker's algorithm.
+	The Banker's algorithm, with the search for the next process to run left to the
+  checker class (see safety.h). The checker reads the matrices of s, a copy of the state
+  is only made when the tracer prints the matrices after every step.
 ********************************************/
-bool safe(struct state* s, int n, int m, int cur_proc, vector<int> suspended, vector<int> processes, string* route)
+template <class checker>
+bool run_safe(struct state* s, int n, int m, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t, workspace<checker>& w)
 {
-    //Create a copy of vector containing the resources currently available.
-    vector<int> current_available = s->available;
+    count_metric(metric_safe_calls, 1);
+    time_phase(phase_check);
 
-    //Create a copy of the state object.
-    state x;
-    state_copy(&x, s, m);
-
-    //A vector of all the processes to be executed.
-    vector<int> rest;
-
-    //Char array to hold int to string conversions.
-    char buffer[10];
+    //Whether the matrices are printed after every step.
+    bool full = t->wants_matrices();
 
+    //Create a copy-on-write snapshot of the state object if it is to be printed.
+    state x;
+    if(full)
+      state_copy(&x, s);
 
     //Add all the processes; the current process, those in queue and those suspened to the rest vector.
+    vector<int>& rest = w.rest;
+    rest.clear();
     rest.push_back(cur_proc);
+    rest.insert(rest.end(), suspended.begin(), suspended.end());
+    rest.insert(rest.end(), processes.begin(), processes.end());
 
-    for(int i = 0; i < suspended.size(); i++)
-    {
-        rest.push_back(suspended[i]);
-    }
+    //The checker holds the resources currently available and picks the next process to run.
+    checker& c = w.c;
+    c.start(s->need, s->allocation, s->available, rest, m);
+    t->begin_check(cur_proc, s->available, s->allocation, m);
 
+    //The process found s.t. claim - allocation <= available resources
+    int p;
 
-    for(int i = 0; i < processes.size(); i++)
+    //Keep simulating processes to completion until none of the remaining ones can run.
+    while((p = c.next()) != -1)
     {
-        rest.push_back(processes[i]);
-    }
-
-    //A flag denote whether the system is still in a safe state and can continue.
-    bool possible = true;
-    //An iterator object to hold the iterator for a vector container.
-    vector<int>::iterator it;
-    //A flag to denote whether a process has been found for which claim - allocation <= available resources
-    bool found;
-
-    while(possible)
-    {
-        found = false;
-        //Among all the vectors remaining in the rest vector find one s.t. claim - allocation <= available resources
-        for(it = rest.begin(); it != rest.end(); ++it)
+        //The checker has already released its allocation, clear its rows in the state copy.
+        if(full)
         {
-            bool all_true = false;
+            int* claim = x.claim.mutable_row(p);
+            int* allocation = x.allocation.mutable_row(p);
+            int* request = x.request.mutable_row(p);
             for(int i = 0; i < m; i++)
             {
-                if(x.claim[*it][i] - x.allocation[*it][i] <= current_available[i])
-                {
-                    all_true = true;
-                }
-                else
-                {
-                    all_true = false;
-                    break;
-                }
-            }
-            if(all_true)
-            {
-                found = true;
-                break;
+                allocation[i] = 0;
+                claim[i] = 0;
+                request[i] = 0;
             }
         }
+        //add the current process as a part of the possible deadlock-free route.
+        route_step(*route, p, c.remaining());
 
-        //If such a vector was found, simulate allocation and update the state object's variables.
-        if(found)
-        {
-            for(int i = 0; i < m; i++)
-            {
-                current_available[i] = current_available[i] + x.allocation[*it][i];
-                x.allocation[*it][i] = 0;
-                x.claim[*it][i] = 0;
-                x.request[*it][i] = 0;
-            }
-            //add the current process as a part of the possible deadlock-free route.
-            *route += "P";
-            snprintf(buffer, 10, "%d", *it+1);
-            *route += buffer;
-            if(rest.size() > 1)
-                *route += " -> ";
-
-            //Print out the route up until now and the updated claim, allocation and request matrices.
-            cout << *route;
-            print_matrix("Claim Matrix", x.claim, n, m);
-            print_matrix("Allocation Matrix", x.allocation, n, m);
-            print_matrix("Request Matrix", x.request, n, m);
-
-            //Print out the vector containing the resoruces currently available
-            cout << "\nAvailable Vector\n";
-            for(int i = 0; i < m; i++)
-            {
-                cout << current_available[i] << " ";
-            }
-            cout << endl << endl << "**************************************" << endl << endl;
-
-            //As long the rest vector isn't empty delete the current process from it since it has
-            // already executed.
-            if(!rest.empty())
-                rest.erase(it);
-        }
-        else
-        {
-            //If no safe route is found break the while loop and return.
-            possible = false;
-        }
+        //Report the route up until now and the updated matrices and available vector.
+        t->step(p, c.remaining(), *route, x.claim, x.allocation, x.request, c.current_available(), n, m);
     }
 
+    t->end_check(c.remaining() == 0, *route);
+
     /*
-    If all the process could execute without the chance of a deadlock then the rest vector is empty
-    and it is a safe state with a corresponding sequence. If an unsafe state was reached then the
-    rest vector isn't empty and the same is reported back.
+    If all the process could execute without the chance of a deadlock then no process is
+    left and it is a safe state with a corresponding sequence. If an unsafe state was reached
+    then some processes remain and the same is reported back.
     */
-    return rest.empty();
+    return c.remaining() == 0;
+}
+
+/********************************************
+Procedure Name: safe()
+Author: 				del_dilettante
+Date: 					 10/18/2020
+Parameters:
+  - s = the state object which has the initial state.
+  - n & m = number of processes and resources.
+  - cur_proc = the process in question
+  - suspend = the vector of suspended processes
+  - processes = the vector of processes yet to be executed.
+  - route = a string to which the sequence of processes will be stored.
+  - t = the tracer the route and matrices are reported to.
+  - w = the scratch space to reuse, a new one is made for this check if NULL.
+Description:
+	The method that implements the Banker's algorithm, using the adaptive checker, which
+  rescans while that is cheap and moves to the incremental checker when it isn't.
+********************************************/
+bool safe(struct state* s, int n, int m, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t = &default_tracer, workspace<adaptive_checker>* w = NULL)
+{
+    if(w != NULL)
+      return run_safe(s, n, m, cur_proc, suspended, processes, route, t, *w);
+    workspace<adaptive_checker> scratch;
+    return run_safe(s, n, m, cur_proc, suspended, processes, route, t, scratch);
+}
+
+/********************************************
+Procedure Name: safe_reference()
+Author: 				del_dilettante
+Date: 					 10/17/2026
+Parameters:
+	Same as safe().
+Description:
+	The Banker's algorithm using the original rescan of the remaining processes. Gives the
+  same result and route as safe(), kept to check faster checkers against.
+********************************************/
+bool safe_reference(struct state* s, int n, int m, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t = &default_tracer)
+{
+    workspace<rescan_checker> scratch;
+    return run_safe(s, n, m, cur_proc, suspended, processes, route, t, scratch);
+}
+
+/********************************************
+Procedure Name: safe_simd()
+Author: 				del_dilettante
+Date: 					 10/17/2026
+Parameters:
+	Same as safe().
+Description:
+	The Banker's algorithm using the rescan with the packed compare kernel.
+********************************************/
+bool safe_simd(struct state* s, int n, int m, int cur_proc, const vector<int>& suspended, const vector<int>& processes, string* route, tracer* t = &default_tracer)
+{
+    workspace<simd_checker> scratch;
+    return run_safe(s, n, m, cur_proc, suspended, processes, route, t, scratch);
 }
 
+/********************************************
+Procedure Name: admission_loop()
+Author: 				del_dilettante
+Date: 					 10/17/2026
+Parameters:
+  - info = the state read in.
+  - n & m = number of processes and resources.
+  - suspended = where the suspended processes are put, in the order they were suspended.
+  - out = the sink told what became of every process (see route_sink).
+
+Description:
+	The admission loop of main(). The processes are taken in order, those whose request is
+  more than their claim are in error and those whose request is more than what is
+  available are suspended. The first process whose request can be granted and leave the
+  state safe stops the loop. The safety check itself is left to out, so the same loop
+  prints a route or fills in a decision record (see decision.h). Returns true if a
+  process was granted its request.
+
+  out has the members
+    void error(int p) - p's request is more than its claim.
+    bool check(struct state* s, int p, const vector<int>& suspended, const vector<int>& processes)
+                      - Whether s, with the request of p granted, is safe.
+    void unsafe(int p) - p's request would leave the state unsafe, p is suspended.
+    void grant(int p) - p is granted its request.
+********************************************/
+template <class sink>
+bool admission_loop(struct state* info, int n, int m, vector<int>& suspended, sink& out)
+{
+  //Create a vector to hold the list of processes
+  vector<int> processes(n, 0);
+
+  //Assign the process numbers to the vector of processes.
+  for(int i = 0; i < n; i++)
+  {
+      processes[i] = i;
+  }
+
+  //Integer to store the index of the current process.
+  int cur_proc = 0;
+
+  //While there are processes which aren't suspended...
+  while(!processes.empty())
+  {
+      //Get a process from the list of processes.
+      cur_proc = processes.front();
+      //Delete that process from the list of processes.
+      processes.erase(processes.begin());
+
+      //If the request for this process is greater than the claim it had, then it is an error state.
+      if(reqGTclaim(*info, cur_proc, m))
+      {
+        out.error(cur_proc);
+        count_metric(metric_errors, 1);
+        continue;
+      }
+      //If the request for this process is greater than the resources available, then suspend it.
+      else if(reqGTavail(*info, cur_proc, m))
+      {
+        suspended.push_back(cur_proc);
+        count_metric(metric_suspended, 1);
+        continue;
+      }
+      //Else, grant the request in place, it is taken back whatever the check finds.
+      else
+      {
+          state_apply(info, cur_proc, 1, m);
+      }
+
+      //Check whether the new state leads to a potentially safe sequence of execution of the processes.
+      bool found = out.check(info, cur_proc, suspended, processes);
+      state_apply(info, cur_proc, -1, m);
+      if(found)
+      {
+        //If there exists a safe sequence the process can be granted its request.
+        count_metric(metric_grants, 1);
+        out.grant(cur_proc);
+        return true;
+      }
+      else
+      {
+        //If no safe sequence is found then suspend the process.
+        suspended.push_back(cur_proc);
+        count_metric(metric_suspended, 1);
+        out.unsafe(cur_proc);
+      }
+  }
+
+  //No process could be granted its request and leave the state safe.
+  return false;
+}
+
+/********************************************
+Class Name: 		    route_sink
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        The sink of admission_loop() for the text output. Every check is made by
+        run_safe() with the checker of w and traced to t, and the route of the
+        process granted is left in route.
+********************************************/
+template <class checker>
+class route_sink
+{
+private:
+  //number of processes and resources
+  int n;
+  int m;
+  //where the route found is stored
+  string* route;
+  //the tracer the output of the checks goes to
+  tracer* t;
+  //the scratch space shared by all the checks
+  workspace<checker>& w;
+
+public:
+  route_sink(int n, int m, string* route, tracer* t, workspace<checker>& w)
+    : n(n), m(m), route(route), t(t), w(w) {}
+
+  void error(int) { t->text("Error State"); }
+
+  bool check(struct state* s, int p, const vector<int>& suspended, const vector<int>& processes)
+  {
+    return run_safe(s, n, m, p, suspended, processes, route, t, w);
+  }
+
+  //Make the string object with the route empty for the next process to be checked.
+  void unsafe(int) { *route = ""; }
+  void grant(int) {}
+};
+
+/********************************************
+Procedure Name: run_admit()
+Author: 				del_dilettante
+Date: 					 10/17/2026
+Parameters:
+  - info = the state read in.
+  - n & m = number of processes and resources.
+  - route = where the route found is stored.
+  - t = the tracer the output of the checks goes to.
+  - w = the scratch space shared by all the checks, its checker makes them.
+
+Description:
+	admission_loop() printing to t. Returns true if a process was granted its request,
+  route then holds its safe sequence.
+********************************************/
+template <class checker>
+bool run_admit(struct state* info, int n, int m, string* route, tracer* t, workspace<checker>& w)
+{
+  //Create a vector to hold the list of suspended processes
+  vector<int> suspended;
+  suspended.reserve(n);
+  time_phase(phase_admit);
+  route_sink<checker> out(n, m, route, t, w);
+  return admission_loop(info, n, m, suspended, out);
+}
+
+/********************************************
+Procedure Name: admit()
+Author: 				del_dilettante
+Date: 					 10/17/2026
+Parameters:
+  - info = the state read in.
+  - n & m = number of processes and resources.
+  - route = where the route found is stored.
+  - t = the tracer the output of the checks goes to.
+
+Description:
+	run_admit() with the adaptive checker safe() uses.
+********************************************/
+bool admit(struct state* info, int n, int m, string* route, tracer* t = &default_tracer)
+{
+  workspace<adaptive_checker> w;
+  return run_admit(info, n, m, route, t, w);
+}
 
 #endif /* header_h */
@@ -0,0 +1,214 @@
+/********************************************
+File Name: 			kernel.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Procedures: Row comparison kernels used by the Banker's algorithm.
+
+bool row_le_scalar(const int* a, const int* b, int m)
+    - Check a[i] <= b[i] for every i < m, one int at a time.
+
+bool row_le_sse2(const int* a, const int* b, int m)
+    - The same check four ints at a time with SSE2 packed compares.
+
+bool row_le_avx2(const int* a, const int* b, int m)
+    - The same check eight ints at a time with AVX2 packed compares.
+
+bool row_le_fixed<M>(const int* a, const int* b, int m)
+    - The same check for rows of M ints, M known at compile time.
+
+row_le_fn pick_row_le()
+    - Pick the widest kernel the CPU running the program supports.
+
+const char* row_le_name()
+    - The name of the kernel row_le points to.
+
+row_le
+    - A pointer to the kernel picked at start up, called like a function.
+********************************************/
+
+#ifndef kernel_h
+#define kernel_h
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define kernel_x86 1
+#endif
+
+/* A row comparison kernel, returns true if a[i] <= b[i] for every i < m */
+typedef bool (*row_le_fn)(const int* a, const int* b, int m);
+
+/********************************************
+Procedure Name: row_le_scalar()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - a & b = the rows to be compared.
+  - m = the number of elements in the rows.
+
+Description:
+	Check a[i] <= b[i] for every i < m, one int at a time. Bails out on the first failure.
+********************************************/
+bool row_le_scalar(const int* a, const int* b, int m)
+{
+  for(int i = 0; i < m; i++)
+  {
+    if(a[i] > b[i])
+      return false;
+  }
+  return true;
+}
+
+/********************************************
+Procedure Name: row_le_fixed()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - a & b = the rows to be compared.
+  - m = the number of elements in the rows, which has to be M.
+
+Description:
+	Check a[i] <= b[i] for every i < M. The whole row is compared without an early exit,
+  for small M that is cheaper than the branches and it unrolls into straight code.
+********************************************/
+template <int M>
+inline bool row_le_fixed(const int* a, const int* b, int)
+{
+  bool le = true;
+  for(int i = 0; i < M; i++)
+  {
+    le &= a[i] <= b[i];
+  }
+  return le;
+}
+
+#ifdef kernel_x86
+
+/********************************************
+Procedure Name: row_le_sse2()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - a & b = the rows to be compared.
+  - m = the number of elements in the rows.
+
+Description:
+	Check a[i] <= b[i] for every i < m with SSE2 packed compares. The compare results of
+  four vectors are or-ed together before branching, the rest is done one int at a time.
+********************************************/
+__attribute__((target("sse2")))
+bool row_le_sse2(const int* a, const int* b, int m)
+{
+  int i = 0;
+  for(; i + 16 <= m; i += 16)
+  {
+    __m128i gt = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(a + i)),
+                                 _mm_loadu_si128((const __m128i*)(b + i)));
+    gt = _mm_or_si128(gt, _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(a + i + 4)),
+                                          _mm_loadu_si128((const __m128i*)(b + i + 4))));
+    gt = _mm_or_si128(gt, _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(a + i + 8)),
+                                          _mm_loadu_si128((const __m128i*)(b + i + 8))));
+    gt = _mm_or_si128(gt, _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(a + i + 12)),
+                                          _mm_loadu_si128((const __m128i*)(b + i + 12))));
+    if(_mm_movemask_epi8(gt) != 0)
+      return false;
+  }
+  for(; i + 4 <= m; i += 4)
+  {
+    __m128i gt = _mm_cmpgt_epi32(_mm_loadu_si128((const __m128i*)(a + i)),
+                                 _mm_loadu_si128((const __m128i*)(b + i)));
+    if(_mm_movemask_epi8(gt) != 0)
+      return false;
+  }
+  return row_le_scalar(a + i, b + i, m - i);
+}
+
+/********************************************
+Procedure Name: row_le_avx2()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - a & b = the rows to be compared.
+  - m = the number of elements in the rows.
+
+Description:
+	Check a[i] <= b[i] for every i < m with AVX2 packed compares. The compare results of
+  four vectors are or-ed together before branching, the rest is done one int at a time.
+********************************************/
+__attribute__((target("avx2")))
+bool row_le_avx2(const int* a, const int* b, int m)
+{
+  int i = 0;
+  for(; i + 32 <= m; i += 32)
+  {
+    __m256i gt = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                    _mm256_loadu_si256((const __m256i*)(b + i)));
+    gt = _mm256_or_si256(gt, _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(a + i + 8)),
+                                                _mm256_loadu_si256((const __m256i*)(b + i + 8))));
+    gt = _mm256_or_si256(gt, _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(a + i + 16)),
+                                                _mm256_loadu_si256((const __m256i*)(b + i + 16))));
+    gt = _mm256_or_si256(gt, _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(a + i + 24)),
+                                                _mm256_loadu_si256((const __m256i*)(b + i + 24))));
+    if(!_mm256_testz_si256(gt, gt))
+      return false;
+  }
+  for(; i + 8 <= m; i += 8)
+  {
+    __m256i gt = _mm256_cmpgt_epi32(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                    _mm256_loadu_si256((const __m256i*)(b + i)));
+    if(!_mm256_testz_si256(gt, gt))
+      return false;
+  }
+  return row_le_scalar(a + i, b + i, m - i);
+}
+
+#endif /* kernel_x86 */
+
+/********************************************
+Procedure Name: pick_row_le()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	None.
+
+Description:
+	Pick the widest kernel the CPU running the program supports, AVX2, then SSE2, then
+  the scalar loop.
+********************************************/
+row_le_fn pick_row_le()
+{
+#ifdef kernel_x86
+  __builtin_cpu_init();
+  if(__builtin_cpu_supports("avx2"))
+    return row_le_avx2;
+  if(__builtin_cpu_supports("sse2"))
+    return row_le_sse2;
+#endif
+  return row_le_scalar;
+}
+
+/* The kernel used by the rest of the program, picked once at start up */
+row_le_fn row_le = pick_row_le();
+
+/********************************************
+Procedure Name: row_le_name()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	None.
+
+Description:
+	The name of the kernel row_le currently points to.
+********************************************/
+const char* row_le_name()
+{
+#ifdef kernel_x86
+  if(row_le == row_le_avx2)
+    return "avx2";
+  if(row_le == row_le_sse2)
+    return "sse2";
+#endif
+  return "scalar";
+}
+
+#endif /* kernel_h */
@@ -1,15 +1,97 @@
 /********************************************
 File Name: 			main.cc
 Author: 				del_dilettante
-Last Modification Date: 10/18/2020
+Last Modification Date: 10/17/2026
 Last Modifier:          del_dilettante
 Procedures:
 
 	main() : The test porgram that runs the resource allocation algorithm and makes
   the procedure call to run the Banker's algorithm.
 
+  Usage: main [-t off|route|full] [-b trace_file] [-j threads] input_file
+         main -f jsonl|binary input_file
+         main -r trace_file
+         main -a input_file
+         main [-c megabytes] [-p cache_file] -s input_file
+         main [-c megabytes] [-p cache_file] -u socket_path input_file
+         main -w snapshot_file input_file
+         main -d input_file
+         main [-j threads] [-l seconds] -e input_file
+         main [-j threads] [-l seconds] [-x peak|wait] -k count input_file
+
+    input_file is either the text format of the assignment or a binary snapshot written
+    with -w (see parser.h), which is mapped and used without being parsed.
+
+    -t  how much of every safety check is printed, the route and matrices after every
+        step (full, the default), only the route each check reached, or nothing.
+        Inputs with 2, 3, 4, 6 or 8 resources are checked by the code specialised for
+        that number of resources (see fixed.h).
+    -b  also write a binary trace of every safety check to trace_file.
+    -j  check the candidate processes on this many threads at once (see parallel.h), the
+        output is the same as with one thread. Can't be used with -b.
+    -f  write the decision as one JSON line or one binary record to stdout instead of
+        text (see decision.h): the process granted, its safe sequence, the available
+        vector after every step and the processes in error and suspended.
+    -r  print the full trace stored in a binary trace file and exit.
+    -a  decide the request of every process in one batch pass (see batch.h) and print
+        which were granted, instead of looking for the first process that can run.
+    -s  keep the state read in and answer events read from stdin (see service.h).
+    -u  keep the state read in and answer events from clients of a Unix domain socket,
+        until SIGINT or SIGTERM.
+    -c  the memory the service may use to cache the answers of safety checks (see
+        cache.h), 64 megabytes by default, 0 turns the cache off.
+    -p  read the cache of the service from cache_file if there is one, and write it back
+        there when the service stops, so the states of earlier runs are answered from it.
+    -w  write the state read in to a binary snapshot and exit.
+    -d  detect deadlock instead of avoiding it (see detect.h), taking the request matrix
+        as what every process is waiting for, and print the deadlocked processes.
+    -e  count the safe sequences of the state read in (see sequences.h).
+    -k  print this many safe sequences of least cost, cheapest first.
+    -x  the cost -k ranks by, the most units in use at once (peak, the default) or the
+        total time processes wait to start (wait).
+    -l  stop -e or -k after this many seconds, the answer is then the best found so far.
+
+    Built with -Dbank_metrics the program also prints its counters and phase timers to
+    stderr at exit (see metrics.h).
+
+	usage() : Print how the program is to be run.
+
 ********************************************/
 #include "header.h"
+#include "service.h"
+#include "batch.h"
+#include "parallel.h"
+#include "parser.h"
+#include "detect.h"
+#include "fixed.h"
+#include "sequences.h"
+#include "decision.h"
+#include "metrics.h"
+
+/********************************************
+Procedure Name: usage()
+Author: 				del_dilettante
+Date: 					 10/17/2026
+Parameters:
+  - prog = the name the program was run with.
+
+Description:
+	Print how the program is to be run.
+********************************************/
+int usage(const char* prog)
+{
+  cerr << "Usage: " << prog << " [-t off|route|full] [-b trace_file] [-j threads] input_file\n"
+       << "       " << prog << " -f jsonl|binary input_file\n"
+       << "       " << prog << " -r trace_file\n"
+       << "       " << prog << " -a input_file\n"
+       << "       " << prog << " [-c megabytes] [-p cache_file] -s input_file\n"
+       << "       " << prog << " [-c megabytes] [-p cache_file] -u socket_path input_file\n"
+       << "       " << prog << " -w snapshot_file input_file\n"
+       << "       " << prog << " -d input_file\n"
+       << "       " << prog << " [-j threads] [-l seconds] -e input_file\n"
+       << "       " << prog << " [-j threads] [-l seconds] [-x peak|wait] -k count input_file\n";
+  return 1;
+}
 
 int main(int argc, char** argv)
 {
@@ -17,146 +99,347 @@ int main(int argc, char** argv)
   int m = 0;
   //Number of processes
   int n = 0;
-  //A variable to hold values read in.
-  int temp = 0;
-  //File stream object to hold the file buffer opened.
-  fstream fs;
   //State struct which holds the current state info for resource alloc and banker's algo.
   state info;
 
   //File string containing the name of the input file to be opened.
-  char* file = argv[1];
-  //Open the input file and create a copy of the buffer in fs object.
-  fs.open(file, fstream::in);
+  char* file = NULL;
+  //File string containing the name of the binary trace to be written, if any.
+  char* trace_file = NULL;
+  //File string containing the name of the snapshot to be written, if any.
+  char* snapshot_file = NULL;
+  //Whether to keep running as a service, and the socket to listen on if not stdin.
+  bool serve = false;
+  char* socket_path = NULL;
+  //Memory the service may use to cache the answers of safety checks, and the file it is kept in.
+  size_t cache_bytes = default_cache_bytes;
+  char* cache_file = NULL;
+  //Whether to decide every request in one batch pass.
+  bool batch = false;
+  //Whether to detect deadlock instead of avoiding it.
+  bool detect = false;
+  //Number of threads the candidate processes are checked on.
+  int threads = 1;
+  //Whether to count the safe sequences, how many of the best to print and by which cost.
+  bool enumerate = false;
+  int best_k = 0;
+  int best_cost = cost_peak;
+  //Seconds the search of the safe sequences may take, 0 for no limit.
+  double budget = 0;
+  //The format of the decision, empty for text.
+  string format;
+
+  //Read in the options, the one argument that isn't an option is the input file.
+  for(int i = 1; i < argc; i++)
+  {
+    string arg = argv[i];
+    if(arg == "-t" && i + 1 < argc)
+    {
+      string level = argv[++i];
+      if(level == "off")
+        default_tracer.level = trace_off;
+      else if(level == "route")
+        default_tracer.level = trace_route;
+      else if(level == "full")
+        default_tracer.level = trace_full;
+      else
+        return usage(argv[0]);
+    }
+    else if(arg == "-f" && i + 1 < argc)
+    {
+      format = argv[++i];
+      if(format != "jsonl" && format != "binary")
+        return usage(argv[0]);
+    }
+    else if(arg == "-b" && i + 1 < argc)
+    {
+      trace_file = argv[++i];
+    }
+    else if(arg == "-r" && i + 1 < argc)
+    {
+      //Replay a trace written earlier instead of running the algorithm.
+      default_tracer.level = trace_full;
+      if(!replay_trace(argv[++i], default_tracer))
+      {
+        cerr << "Could not read trace " << argv[i] << endl;
+        return 1;
+      }
+      return 0;
+    }
+    else if(arg == "-j" && i + 1 < argc)
+    {
+      threads = atoi(argv[++i]);
+      if(threads < 1)
+        return usage(argv[0]);
+    }
+    else if(arg == "-w" && i + 1 < argc)
+    {
+      snapshot_file = argv[++i];
+    }
+    else if(arg == "-a")
+    {
+      batch = true;
+    }
+    else if(arg == "-d")
+    {
+      detect = true;
+    }
+    else if(arg == "-c" && i + 1 < argc)
+    {
+      cache_bytes = (size_t)atoi(argv[++i]) << 20;
+    }
+    else if(arg == "-p" && i + 1 < argc)
+    {
+      cache_file = argv[++i];
+    }
+    else if(arg == "-e")
+    {
+      enumerate = true;
+    }
+    else if(arg == "-k" && i + 1 < argc)
+    {
+      best_k = atoi(argv[++i]);
+      if(best_k < 1)
+        return usage(argv[0]);
+    }
+    else if(arg == "-x" && i + 1 < argc)
+    {
+      string by = argv[++i];
+      if(by == "peak")
+        best_cost = cost_peak;
+      else if(by == "wait")
+        best_cost = cost_wait;
+      else
+        return usage(argv[0]);
+    }
+    else if(arg == "-l" && i + 1 < argc)
+    {
+      budget = atof(argv[++i]);
+    }
+    else if(arg == "-s")
+    {
+      serve = true;
+    }
+    else if(arg == "-u" && i + 1 < argc)
+    {
+      serve = true;
+      socket_path = argv[++i];
+    }
+    else if(arg[0] != '-' && file == NULL)
+    {
+      file = argv[i];
+    }
+    else
+    {
+      return usage(argv[0]);
+    }
+  }
+
+  if(file == NULL || (threads > 1 && trace_file != NULL))
+    return usage(argv[0]);
 
-  //Read the number of resources.
-  fs >> m;
+  //Print the counters and timers at exit when built with -Dbank_metrics (see metrics.h).
+  metrics_at_exit();
 
-  //Read in the resource vector and create a copy of it in the available vector.
-  for(int i = 0; i < m; i++)
+  //Read the input file, a text file or a binary snapshot.
+  bool loaded;
+  {
+    time_phase(phase_load);
+    loaded = load_state(file, info, n, m);
+  }
+  if(!loaded)
   {
-    fs >> temp;
-    info.resource.push_back(temp);
-    info.available.push_back(temp);
+    cerr << "Could not read " << file << endl;
+    return 1;
   }
 
-  //Read the number of processes.
-  fs >> n;
+  //Save the state as a snapshot, which later runs can map without parsing.
+  if(snapshot_file != NULL)
+  {
+    if(!save_snapshot(snapshot_file, info, n, m))
+    {
+      cerr << "Could not write " << snapshot_file << endl;
+      return 1;
+    }
+    return 0;
+  }
 
-  //Read in the claim matrix.
-  for(int i = 0; i < n; i++)
+  //Find the processes that are deadlocked already, with the wait-for graph if every resource has one unit.
+  if(detect)
   {
-    vector<int> x(m, 0);
-    info.claim.push_back(x);
+    vector<int> deadlocked;
+    if(all_of(info.resource.begin(), info.resource.end(), [](int units) { return units <= 1; }))
+    {
+      wait_for_graph graph(info, n, m);
+      deadlocked = graph.detect();
+    }
+    else
+    {
+      deadlock_detector detector(info, n, m);
+      deadlocked = detector.detect();
+    }
 
-    for(int j = 0; j < m; j++)
+    if(deadlocked.empty())
+    {
+      cout << "No deadlock.\n";
+      return 0;
+    }
+    cout << "Deadlocked processes:";
+    for(size_t k = 0; k < deadlocked.size(); k++)
     {
-      fs >> temp;
-      info.claim[i][j] = temp;
+      cout << " P" << deadlocked[k] + 1;
     }
+    cout << "\n";
+    return 0;
   }
 
-  //Read in the allocation matrix and calculate the request matrix and available vector using it.
-  for(int i = 0; i < n; i++)
+  //Count the safe sequences of the state read in, or print the best of them.
+  if(enumerate || best_k > 0)
   {
-    vector<int> x(m, 0);
-    info.allocation.push_back(x);
-    info.request.push_back(x);
+    if(n > 64)
+    {
+      cerr << "Safe sequences can only be searched for up to 64 processes.\n";
+      return 1;
+    }
+    thread_pool pool(threads);
+    sequence_search search(info, n, m);
+    search.set_budget(budget);
+    if(enumerate)
+    {
+      seq_count count = search.count(&pool);
+      cout << "Safe sequences: " << (search.complete() && count != seq_count_max ? "" : "at least ") << count_text(count) << "\n";
+    }
+    if(best_k > 0)
+    {
+      vector<ranked_sequence> best = search.best(best_k, best_cost);
+      if(best.empty())
+        cout << "The system is in an unsafe state.\n";
+      for(size_t i = 0; i < best.size(); i++)
+      {
+        cout << best[i].cost << ":";
+        for(size_t k = 0; k < best[i].order.size(); k++)
+        {
+          cout << (k == 0 ? " P" : " -> P") << best[i].order[k] + 1;
+        }
+        cout << "\n";
+      }
+      if(!search.complete())
+        cout << "The time limit was reached, better sequences may exist.\n";
+    }
+    return 0;
+  }
 
-    for(int j = 0; j < m; j++)
+  //Answer events against the state just read in until there are no more.
+  if(serve)
+  {
+    admission_service service(info, n, m, cache_bytes);
+    //A missing cache file is fine, it is written when the service stops.
+    if(cache_file != NULL && access(cache_file, F_OK) == 0 && !service.checks().load(cache_file))
+      cerr << "Could not read cache " << cache_file << ", starting empty" << endl;
+    if(socket_path == NULL)
+    {
+      serve_stream(service, cin, cout);
+    }
+    else if(!serve_socket(service, socket_path))
+    {
+      cerr << "Could not listen on " << socket_path << endl;
+      return 1;
+    }
+    if(cache_file != NULL && service.checks().enabled() && !service.checks().save(cache_file))
+    {
+      cerr << "Could not write cache " << cache_file << endl;
+      return 1;
+    }
+    return 0;
+  }
+
+  //Decide the request of every process in one pass and report which were granted.
+  if(batch)
+  {
+    vector<int> all(n);
+    for(int i = 0; i < n; i++)
     {
+      all[i] = i;
+    }
+    batch_admitter admitter(&info, n, m, all);
+    vector<int> answers = admitter.admit_all(all, info.request);
 
-      fs >> temp;
-      info.allocation[i][j] = temp;
-      info.available[j] -= temp;
-      info.request[i][j] = info.claim[i][j] - temp;
+    const char* labels[3] = {"Error State:", "Requests denied:", "Requests granted in one pass:"};
+    for(int answer = event_grant; answer >= event_error; answer--)
+    {
+      string line = labels[answer + 1];
+      bool any = false;
+      for(int i = 0; i < n; i++)
+      {
+        if(answers[i] == answer)
+        {
+          line += " P" + to_string(i + 1);
+          any = true;
+        }
+      }
+      if(any || answer != event_error)
+        cout << line << "\n";
     }
+    return 0;
+  }
+
+  //Write the decision as a record rather than text.
+  if(!format.empty())
+  {
+    decision d;
+    workspace<adaptive_checker> w;
+    decide(&info, n, m, d, w);
+    time_phase(phase_output);
+    record_writer out(stdout);
+    if(format == "jsonl")
+      out.jsonl(d, m);
+    else
+      out.binary(d, m);
+    out.flush();
+    return 0;
   }
-  //Create a vector to hold the list of processes
-  vector<int> processes(n, 0);
-  //Create a vector to hold the list of suspended processes
-  vector<int> suspended;
-  //Create a string to hold the process allocation path.
-  string route;
 
-  //Assign the process numbers to the vector of processes.
-  for(int i = 0; i < n; i++)
+  //Start the binary trace with the state just read in.
+  if(trace_file != NULL && !default_tracer.open_binary(trace_file, info.claim, info.allocation, info.request, n, m))
   {
-      processes[i] = i;
+    cerr << "Could not open trace " << trace_file << endl;
+    return 1;
   }
 
-  //Integer to store the index of the current process.
-  int cur_proc = 0;
+  //Create a string to hold the process allocation path.
+  string route;
 
   //Flag that informs whether or not a route that prevents deadlock was found.
   bool found_a_route = false;
 
-  //While there are processes which aren't suspended...
-  while(!processes.empty())
+  //Check all the candidates on several threads at once if asked to, otherwise one after another.
+  if(threads > 1)
   {
-      //Create an instance of the state struct to save the newstate.
-      state newstate;
-      //Copy the current state into the newstate object.
-      state_copy(&newstate, &info, m);
-      //Get a process from the list of processes.
-      cur_proc = processes.front();
-      //Delete that process from the list of processes.
-      processes.erase(processes.begin());
-
-      //If the request for this process is greater than the claim it had, then it is an error state.
-      if(reqGTclaim(info, cur_proc, m))
-      {
-        cout << "Error State";
-        continue;
-      }
-      //If the request for this process is greater than the resources available, then suspend it.
-      else if(reqGTavail(info, cur_proc, m))
-      {
-        suspended.push_back(cur_proc);
-        continue;
-      }
-      //Else, calculate and update newstate values.
-      else
-      {
-          for(int i = 0; i < m; i++)
-          {
-              newstate.allocation[cur_proc][i] = info.allocation[cur_proc][i] + info.request[cur_proc][i];
-              newstate.available[i] = info.available[i] - info.request[cur_proc][i];
-          }
-      }
-
-      //Check whether the newstate leads to a potentially safe sequence of execution of the processes.
-      if(safe(&newstate, n, m, cur_proc, suspended, processes, &route))
-      {
-        //If there exists a safe sequence mark the flag true.
-        found_a_route = true;
-        //Break the while loop and go to exit sequence..
-        break;
-      }
-      else
-      {
-        //If no safe sequence is found then suspend the process.
-        suspended.push_back(cur_proc);
-        //Make the string object with the route empty for the next process to be checked.
-        route = "";
-      }
+    thread_pool pool(threads);
+    found_a_route = parallel_admit(&info, n, m, pool, &default_tracer, &route);
+  }
+  else
+  {
+    found_a_route = admit_dispatch(&info, n, m, &route);
+  }
 
-    }
+    time_phase(phase_output);
 
     //If a sequence of process execution avoiding deadlock was found.
     if(found_a_route)
     {
       //Print the sequence as found.
-      cout << "The sequence for preventing deadlock is: \n" << route << endl;
+      default_tracer.text("The sequence for preventing deadlock is: \n" + route + "\n");
     }
     //If a sequence wasn't found.
     else
     {
       //The system encountered an unsafe state for all processes.
-      cout << "The system was in an unsafe state.\n";
+      default_tracer.text("The system was in an unsafe state.\n");
       //Print out the last process' route after which unsafe state was encountered.
-      cout << route;
+      default_tracer.text(route);
     }
 
+    default_tracer.flush();
     return 0;
 }
@@ -0,0 +1,179 @@
+/********************************************
+File Name: 			matrix.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Struct:
+	 row_view - A read only view of one row of a matrix.
+
+Class:
+	 matrix - A dense n x m matrix of ints stored as one row-major buffer. Every row is padded
+	          to a whole number of cache lines and copies share the buffer until one of them
+	          is written to (copy-on-write).
+
+Procedures: Members of the matrix class.
+
+matrix(int rows, int cols)
+    - Allocate a zeroed rows x cols matrix.
+
+matrix(shared_ptr<int> data, int rows, int cols, int stride)
+    - Use rows already laid out in memory, such as a mapped file, without copying them.
+
+row_view row(int i) const
+    - A read only view of row i, no copy is made.
+
+int* mutable_row(int i)
+    - A writable pointer to row i, detaches the buffer from any other copies first.
+
+int stride() const
+    - The distance in ints between the start of two consecutive rows.
+
+void resize_rows(int rows)
+    - Change the number of rows, new rows are zeroed. Room for more rows is kept so that
+      adding rows one at a time is amortised O(m).
+********************************************/
+
+#ifndef matrix_h
+#define matrix_h
+
+#include <stdlib.h>
+#include <string.h>
+#include <memory>
+#include <algorithm>
+
+using namespace std;
+
+/* Macro denoting the number of ints in one 64 byte cache line */
+#define cache_line_ints 16
+
+/********************************************
+Structure Name: 		row_view
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        A read only view of one row of a matrix. It only holds a pointer into the
+        matrix buffer, so it is only valid as long as the matrix isn't written to.
+********************************************/
+struct row_view
+{
+  //first element of the row
+  const int* data;
+  //number of elements in the row
+  int size;
+
+  int operator[](int j) const { return data[j]; }
+  const int* begin() const { return data; }
+  const int* end() const { return data + size; }
+};
+
+/********************************************
+Class Name: 		    matrix
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        A dense matrix of ints stored as one row-major buffer aligned to a cache line.
+        Rows are padded so that each one starts on its own cache line. Copying a matrix
+        is O(1), the copies share the buffer and the first write through mutable_row()
+        gives the writer its own copy.
+********************************************/
+class matrix
+{
+private:
+  //the shared buffer holding n_rows * row_stride ints
+  shared_ptr<int> buffer;
+  //number of rows
+  int n_rows;
+  //number of columns in use
+  int n_cols;
+  //number of ints between the start of two rows, a multiple of cache_line_ints
+  int row_stride;
+  //number of rows the buffer has room for
+  int row_capacity;
+
+  //Allocate a zeroed, cache line aligned buffer for the current dimensions.
+  static shared_ptr<int> allocate(size_t ints)
+  {
+    if(ints == 0)
+      return shared_ptr<int>();
+    int* p = static_cast<int*>(aligned_alloc(cache_line_ints * sizeof(int), ints * sizeof(int)));
+    if(p == NULL)
+      throw bad_alloc();
+    memset(p, 0, ints * sizeof(int));
+    return shared_ptr<int>(p, free);
+  }
+
+  //Move the rows in use to a buffer of its own with room for capacity rows.
+  void reallocate(int capacity)
+  {
+    shared_ptr<int> own = allocate((size_t)capacity * row_stride);
+    if(buffer)
+      memcpy(own.get(), buffer.get(), size() * sizeof(int));
+    buffer = own;
+    row_capacity = capacity;
+  }
+
+  //Give this matrix its own copy of the buffer if it is shared with another matrix.
+  void detach()
+  {
+    if(buffer && buffer.use_count() > 1)
+      reallocate(n_rows);
+  }
+
+public:
+  matrix() : n_rows(0), n_cols(0), row_stride(0), row_capacity(0) {}
+
+  matrix(int rows, int cols)
+    : n_rows(rows), n_cols(cols),
+      row_stride((cols + cache_line_ints - 1) / cache_line_ints * cache_line_ints),
+      row_capacity(rows)
+  {
+    buffer = allocate(size());
+  }
+
+  //Adopt a buffer laid out like ours, it is copied only when first written to through a copy.
+  matrix(shared_ptr<int> data, int rows, int cols, int stride)
+    : buffer(data), n_rows(rows), n_cols(cols), row_stride(stride), row_capacity(rows)
+  {
+  }
+
+  int rows() const { return n_rows; }
+  int cols() const { return n_cols; }
+  int stride() const { return row_stride; }
+
+  //Total number of ints in the buffer, padding included.
+  size_t size() const { return (size_t)n_rows * row_stride; }
+
+  row_view row(int i) const
+  {
+    row_view r = { buffer.get() + (size_t)i * row_stride, n_cols };
+    return r;
+  }
+
+  int* mutable_row(int i)
+  {
+    detach();
+    return buffer.get() + (size_t)i * row_stride;
+  }
+
+  void resize_rows(int rows)
+  {
+    if(rows > row_capacity)
+      reallocate(max(rows, 2 * row_capacity));
+    else if(buffer && buffer.use_count() > 1)
+      reallocate(row_capacity);
+    //Rows past the old end may hold values from before an earlier shrink.
+    if(rows > n_rows)
+      memset(buffer.get() + size(), 0, (size_t)(rows - n_rows) * row_stride * sizeof(int));
+    n_rows = rows;
+  }
+
+  int operator()(int i, int j) const { return buffer.get()[(size_t)i * row_stride + j]; }
+};
+
+#endif /* matrix_h */
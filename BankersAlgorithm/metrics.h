@@ -0,0 +1,296 @@
+/********************************************
+File Name: 			metrics.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Macros:
+	 count_metric(id, amount) - Add amount to counter id of the calling thread.
+
+	 time_phase(id) - Add the time until the end of the enclosing block to the timer
+	                  of phase id of the calling thread.
+
+	 metrics_at_exit() - Print the summary table to stderr when the program exits.
+
+All three expand to nothing unless the program is built with -Dbank_metrics, so a
+normal build carries no trace of them.
+
+Structs:
+	 metric_block - The counters and phase timers of one thread.
+
+	 thread_metrics - Registers the block of a thread and folds it in when it exits.
+
+Classes:
+	 metrics_registry - Every metric_block in use, and the sum of those of threads that
+	                    have exited.
+
+	 phase_timer - Adds the time it is alive to a phase.
+
+Procedures:
+
+metrics_registry& metrics()
+    - The registry of the program.
+
+metric_block& local_metrics()
+    - The block of the calling thread, registered on first use.
+
+void print_metrics()
+    - Print the summary table to stderr.
+
+void print_metrics_at_exit()
+    - Make the registry and have print_metrics() run at exit.
+
+Procedures: Members of the metrics_registry class.
+
+void add_block(metric_block* b), void remove_block(metric_block* b)
+    - Start adding up the counters of a thread, or fold them in as it exits.
+
+metric_block total()
+    - The sum over all threads.
+
+void print(ostream& os)
+    - Print the summary table.
+********************************************/
+
+#ifndef metrics_h
+#define metrics_h
+
+/* Counters */
+#define metric_safe_calls 0
+#define metric_rows_scanned 1
+#define metric_suspended 2
+#define metric_errors 3
+#define metric_grants 4
+#define metric_counters 5
+
+/* Phases timed */
+#define phase_load 0
+#define phase_admit 1
+#define phase_check 2
+#define phase_output 3
+#define metric_phases 4
+
+#ifdef bank_metrics
+
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+/********************************************
+Structure Name: 		metric_block
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        The counters of one thread. Only that thread writes them, so they are plain
+        integers and counting is one add to a line no other thread touches.
+********************************************/
+struct alignas(64) metric_block
+{
+  //the counters, indexed by the metric_ macros
+  long long counts[metric_counters];
+  //nanoseconds spent in every phase, and the times it was entered
+  long long ns[metric_phases];
+  long long entered[metric_phases];
+};
+
+/********************************************
+Class Name: 		    metrics_registry
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Keeps a pointer to the block of every thread that has counted something, and
+        the sum of the blocks of threads that have exited. The total is read without
+        stopping the threads, so it is only exact when none of them is counting, as
+        at exit.
+********************************************/
+class metrics_registry
+{
+private:
+  mutex mtx;
+  vector<metric_block*> blocks;
+  metric_block retired;
+
+  static void add(metric_block& to, const metric_block& from)
+  {
+    for(int i = 0; i < metric_counters; i++)
+    {
+      to.counts[i] += from.counts[i];
+    }
+    for(int i = 0; i < metric_phases; i++)
+    {
+      to.ns[i] += from.ns[i];
+      to.entered[i] += from.entered[i];
+    }
+  }
+
+public:
+  metrics_registry() { memset(&retired, 0, sizeof(retired)); }
+
+  void add_block(metric_block* b)
+  {
+    lock_guard<mutex> lock(mtx);
+    blocks.push_back(b);
+  }
+
+  void remove_block(metric_block* b)
+  {
+    lock_guard<mutex> lock(mtx);
+    add(retired, *b);
+    blocks.erase(find(blocks.begin(), blocks.end(), b));
+  }
+
+  metric_block total()
+  {
+    lock_guard<mutex> lock(mtx);
+    metric_block sum = retired;
+    for(size_t i = 0; i < blocks.size(); i++)
+    {
+      add(sum, *blocks[i]);
+    }
+    return sum;
+  }
+
+  void print(ostream& os)
+  {
+    static const char* counters[metric_counters] = {"safe() calls", "rows scanned", "suspended", "error states", "grants"};
+    static const char* phases[metric_phases] = {"load", "admit", "check", "output"};
+    metric_block t = total();
+
+    os << "\n" << left << setw(16) << "counter" << right << setw(16) << "count" << setw(16) << "per check" << "\n";
+    for(int i = 0; i < metric_counters; i++)
+    {
+      os << left << setw(16) << counters[i] << right << setw(16) << t.counts[i];
+      if(t.counts[metric_safe_calls] > 0)
+        os << setw(16) << fixed << setprecision(1) << (double)t.counts[i] / t.counts[metric_safe_calls];
+      os << "\n";
+    }
+    os << left << setw(16) << "phase" << right << setw(16) << "ms" << setw(16) << "entered" << setw(16) << "ns each" << "\n";
+    for(int i = 0; i < metric_phases; i++)
+    {
+      os << left << setw(16) << phases[i] << right << setw(16) << fixed << setprecision(3) << t.ns[i] / 1e6
+         << setw(16) << t.entered[i] << setw(16) << setprecision(0)
+         << (t.entered[i] > 0 ? (double)t.ns[i] / t.entered[i] : 0.0) << "\n";
+    }
+  }
+};
+
+/********************************************
+Procedure Name: metrics()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	None.
+
+Description:
+	The registry of the program. It is made on first use, before any thread's block, so
+  it is destroyed after all of them.
+********************************************/
+inline metrics_registry& metrics()
+{
+  static metrics_registry registry;
+  return registry;
+}
+
+/********************************************
+Structure Name: 		thread_metrics
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        The block of one thread, registered when the thread first counts something
+        and folded into the registry when it exits.
+********************************************/
+struct thread_metrics
+{
+  metric_block block;
+
+  thread_metrics()
+  {
+    memset(&block, 0, sizeof(block));
+    metrics().add_block(&block);
+  }
+  ~thread_metrics() { metrics().remove_block(&block); }
+};
+
+inline metric_block& local_metrics()
+{
+  static thread_local thread_metrics t;
+  return t.block;
+}
+
+/********************************************
+Class Name: 		    phase_timer
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Adds the time from its construction to its destruction to a phase of the
+        calling thread.
+********************************************/
+class phase_timer
+{
+private:
+  int phase;
+  chrono::steady_clock::time_point start;
+
+public:
+  phase_timer(int id) : phase(id), start(chrono::steady_clock::now()) {}
+  ~phase_timer()
+  {
+    metric_block& b = local_metrics();
+    b.ns[phase] += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    b.entered[phase]++;
+  }
+};
+
+inline void print_metrics() { metrics().print(cerr); }
+
+/********************************************
+Procedure Name: print_metrics_at_exit()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	None.
+
+Description:
+	Have print_metrics() run at exit. The registry is made first: objects with static
+  storage and atexit() handlers are undone in the reverse order they were made and
+  registered in, so the registry is then destroyed after the handler has read it.
+********************************************/
+inline void print_metrics_at_exit()
+{
+  metrics();
+  atexit(print_metrics);
+}
+
+#define metric_join2(a, b) a##b
+#define metric_join(a, b) metric_join2(a, b)
+#define count_metric(id, amount) (local_metrics().counts[id] += (amount))
+#define time_phase(id) phase_timer metric_join(phase_timer_, __LINE__)(id)
+#define metrics_at_exit() print_metrics_at_exit()
+
+#else
+
+#define count_metric(id, amount) ((void)0)
+#define time_phase(id) ((void)0)
+#define metrics_at_exit() ((void)0)
+
+#endif /* bank_metrics */
+
+#endif /* metrics_h */
@@ -0,0 +1,155 @@
+/********************************************
+File Name: 			parallel.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Class:
+	 replay_sink - The sink of admission_loop() (see header.h) that hands out the checks
+	               already made on the threads instead of making them.
+
+Procedures:
+
+bool parallel_admit(struct state* info, int n, int m, thread_pool& pool, tracer* out, string* route)
+    - The admission loop of admit(), with the candidate processes checked on all the
+      threads of pool at once. Prints and returns exactly what admit() does.
+********************************************/
+
+#ifndef parallel_h
+#define parallel_h
+
+#include <atomic>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "header.h"
+#include "threadpool.h"
+
+using namespace std;
+
+/********************************************
+Class Name: 		    replay_sink
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Replays the checks parallel_admit() made, in the order admission_loop() asks
+        for them: the output of every check goes on to out and only the winner is
+        safe. Running the loop over it keeps what is printed and counted the same as
+        the serial loop.
+********************************************/
+class replay_sink
+{
+private:
+  //the tracer the output goes to
+  tracer* out;
+  //the output and route of every candidate
+  const vector<string>& text;
+  const vector<string>& routes;
+  //the lowest candidate found safe, n if none was
+  int winner;
+  //where the route of the winner is stored
+  string* route;
+
+public:
+  replay_sink(tracer* out, const vector<string>& text, const vector<string>& routes, int winner, string* route)
+    : out(out), text(text), routes(routes), winner(winner), route(route) {}
+
+  void error(int) { out->text("Error State"); }
+
+  bool check(struct state*, int p, const vector<int>&, const vector<int>&)
+  {
+    out->text(text[p]);
+    return p == winner;
+  }
+
+  void unsafe(int) {}
+  void grant(int p) { *route = routes[p]; }
+};
+
+/********************************************
+Procedure Name: parallel_admit()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - info = the state read in.
+  - n & m = number of processes and resources.
+  - pool = the threads the candidates are checked on.
+  - out = the tracer the output of the checks goes to, in the order the serial loop
+          would print it.
+  - route = where the route found is stored.
+
+Description:
+	The admission loop of admit() run in parallel. In the serial loop every process before
+  the one that is granted was either in error or suspended, so the check of candidate k
+  only depends on k: it sees the processes before it that weren't in error as suspended
+  and the ones after it as still to come. Every candidate is checked on its own copy of
+  the state with its own tracer writing to a string. The lowest candidate found safe wins,
+  which is the one the serial loop would have stopped at, and candidates after it that
+  haven't started yet are skipped. admission_loop() is then run over a replay_sink, which
+  passes the output of the candidates up to the winner on to out in order. Returns true
+  if a safe sequence was found.
+********************************************/
+bool parallel_admit(struct state* info, int n, int m, thread_pool& pool, tracer* out, string* route)
+{
+  time_phase(phase_admit);
+
+  //Work out which processes are in error and how many before each one aren't.
+  vector<char> error(n);
+  vector<int> before(n);
+  vector<int> not_error;
+  for(int k = 0; k < n; k++)
+  {
+    error[k] = reqGTclaim(*info, k, m);
+    before[k] = not_error.size();
+    if(!error[k])
+      not_error.push_back(k);
+  }
+
+  //The output and route of every candidate, and the lowest one found safe so far.
+  vector<string> text(n);
+  vector<string> routes(n);
+  atomic<int> winner(n);
+
+  pool.parallel_for(n, [&](int k)
+  {
+    if(k > winner.load() || error[k] || reqGTavail(*info, k, m))
+      return;
+
+    state newstate;
+    state_copy(&newstate, info);
+    state_grant(&newstate, info, k, m);
+
+    vector<int> suspended(not_error.begin(), not_error.begin() + before[k]);
+    vector<int> processes;
+    processes.reserve(n - k - 1);
+    for(int i = k + 1; i < n; i++)
+    {
+      processes.push_back(i);
+    }
+
+    ostringstream os;
+    tracer t(os, out->level);
+    bool found = safe(&newstate, n, m, k, suspended, processes, &routes[k], &t);
+    t.flush();
+    text[k] = os.str();
+
+    //Keep the lowest safe candidate.
+    if(found)
+    {
+      int w = winner.load();
+      while(k < w && !winner.compare_exchange_weak(w, k));
+    }
+  });
+
+  //Pass the output on in the order the serial loop would have printed it.
+  *route = "";
+  vector<int> suspended;
+  suspended.reserve(n);
+  replay_sink replay(out, text, routes, winner.load(), route);
+  return admission_loop(info, n, m, suspended, replay);
+}
+
+#endif /* parallel_h */
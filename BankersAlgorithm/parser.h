@@ -0,0 +1,334 @@
+/********************************************
+File Name: 			parser.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Struct:
+	 int_scanner - Reads whitespace separated ints out of a block of memory.
+
+Snapshot format (all values native endian int32, every block starts on a cache line):
+	 header     - 'B' 'K' 'S' 'N', version, n, m, the row stride, padded to 16 ints.
+	 vectors    - the resource and available vectors, one padded row each.
+	 matrices   - the claim, allocation and need matrices, n padded rows each.
+	 The rows are laid out exactly as in a matrix, so a snapshot is mapped and used in
+	 place. The request matrix of a new state is its need matrix and shares its rows.
+
+Procedures:
+
+bool is_blank(char c)
+    - Whether c is whitespace, as fstream >> int skips it.
+
+bool load_text(const char* path, struct state& info, int& n, int& m)
+    - Read an input file in the text format of the assignment into info.
+
+bool load_snapshot(const char* path, struct state& info, int& n, int& m)
+    - Map a binary snapshot and point the matrices of info at it, nothing is copied.
+
+bool save_snapshot(const char* path, const struct state& info, int n, int m)
+    - Write info out as a binary snapshot.
+
+bool load_state(const char* path, struct state& info, int& n, int& m)
+    - Read either kind of file, telling them apart by the first four bytes.
+********************************************/
+
+#ifndef parser_h
+#define parser_h
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdio.h>
+#include <string.h>
+#include <charconv>
+#include <memory>
+
+#include "header.h"
+
+using namespace std;
+
+/* Snapshot header, the magic number, version and header size in ints */
+#define snapshot_magic "BKSN"
+#define snapshot_version 1
+#define snapshot_header_ints cache_line_ints
+
+/********************************************
+Procedure Name: is_blank()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - c = the character to be tested.
+
+Description:
+	Whether c is one of the whitespace characters fstream >> int skips, in the C locale.
+********************************************/
+inline bool is_blank(char c)
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+/********************************************
+Structure Name: 		int_scanner
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        Reads whitespace separated ints out of a block of memory with from_chars, the
+        same values fstream >> int would read but without a stream or locale in the way.
+********************************************/
+struct int_scanner
+{
+  //next character to be read
+  const char* p;
+  //one past the last character
+  const char* end;
+
+  //Read the next int into v, false at the end of the input or on anything that isn't an int.
+  bool next(int& v)
+  {
+    while(p < end && is_blank(*p))
+    {
+      p++;
+    }
+    from_chars_result r = from_chars(p, end, v);
+    if(r.ec != errc())
+      return false;
+    p = r.ptr;
+    return true;
+  }
+};
+
+/********************************************
+Procedure Name: map_file()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the file to be mapped.
+  - length = where the size of the file is stored.
+  - writable = whether the mapping may be written to. Writes are never carried through to
+               the file, pages written to become private copies.
+
+Description:
+	Map the whole of a file into memory. The mapping is released when the last copy of
+  the pointer returned goes away. Returns an empty pointer if the file can't be mapped.
+********************************************/
+shared_ptr<char> map_file(const char* path, size_t* length, bool writable)
+{
+  int fd = open(path, O_RDONLY);
+  if(fd < 0)
+    return shared_ptr<char>();
+  struct stat st;
+  if(fstat(fd, &st) < 0 || st.st_size == 0)
+  {
+    close(fd);
+    return shared_ptr<char>();
+  }
+  size_t size = st.st_size;
+  void* p = mmap(NULL, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+  //The mapping stays valid once the file is closed.
+  close(fd);
+  if(p == MAP_FAILED)
+    return shared_ptr<char>();
+
+  *length = size;
+  return shared_ptr<char>(static_cast<char*>(p), [size](char* q) { munmap(q, size); });
+}
+
+/********************************************
+Procedure Name: load_text()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the input file.
+  - info = the state to be filled in.
+  - n & m = where the number of processes and resources are stored.
+
+Description:
+	Read an input file: the number of resources, the resource vector, the number of
+  processes, then the claim and allocation matrices. The file is mapped and scanned in
+  one pass straight into the rows of the matrices, which are allocated once n and m are
+  known. The available vector and need matrix are worked out along the way. Returns
+  false if the file can't be read or ends early.
+********************************************/
+bool load_text(const char* path, struct state& info, int& n, int& m)
+{
+  size_t length = 0;
+  shared_ptr<char> file = map_file(path, &length, false);
+  if(!file)
+    return false;
+  madvise(file.get(), length, MADV_SEQUENTIAL);
+  int_scanner in = { file.get(), file.get() + length };
+
+  //Read the number of resources and the resource vector.
+  if(!in.next(m) || m < 0)
+    return false;
+  info.resource.assign(m, 0);
+  for(int j = 0; j < m; j++)
+  {
+    if(!in.next(info.resource[j]))
+      return false;
+  }
+  info.available = info.resource;
+
+  //Every value takes at least two characters, so a bad n is caught before allocating.
+  if(!in.next(n) || n < 0 || (m > 0 && (size_t)n * m > length / 2 + 1))
+    return false;
+  info.claim = matrix(n, m);
+  info.allocation = matrix(n, m);
+  info.need = matrix(n, m);
+
+  for(int i = 0; i < n; i++)
+  {
+    int* claim = info.claim.mutable_row(i);
+    for(int j = 0; j < m; j++)
+    {
+      if(!in.next(claim[j]))
+        return false;
+    }
+  }
+
+  for(int i = 0; i < n; i++)
+  {
+    row_view claim = info.claim.row(i);
+    int* allocation = info.allocation.mutable_row(i);
+    int* need = info.need.mutable_row(i);
+    for(int j = 0; j < m; j++)
+    {
+      if(!in.next(allocation[j]))
+        return false;
+      info.available[j] -= allocation[j];
+      need[j] = claim[j] - allocation[j];
+    }
+  }
+
+  //Every process asks for the rest of its claim, the two share rows until one is written.
+  info.request = info.need;
+  return true;
+}
+
+/********************************************
+Procedure Name: load_snapshot()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the snapshot file.
+  - info = the state to be filled in.
+  - n & m = where the number of processes and resources are stored.
+
+Description:
+	Map a snapshot written by save_snapshot() and point the claim, allocation, request and
+  need matrices of info straight at its rows. Only the resource and available vectors
+  are copied. The mapping is private, so writing to the state never changes the file,
+  and it is kept alive for as long as any of the matrices use it. Returns false if the
+  file isn't a snapshot or doesn't match the size in its header.
+********************************************/
+bool load_snapshot(const char* path, struct state& info, int& n, int& m)
+{
+  size_t length = 0;
+  shared_ptr<char> file = map_file(path, &length, true);
+  if(!file || length < snapshot_header_ints * sizeof(int))
+    return false;
+
+  const int* header = reinterpret_cast<const int*>(file.get());
+  if(memcmp(header, snapshot_magic, 4) != 0 || header[1] != snapshot_version)
+    return false;
+  n = header[2];
+  m = header[3];
+  int stride = header[4];
+  if(n < 0 || m < 0 || stride != (m + cache_line_ints - 1) / cache_line_ints * cache_line_ints)
+    return false;
+  size_t rows = (size_t)n * stride;
+  if(length != (snapshot_header_ints + 2 * (size_t)stride + 3 * rows) * sizeof(int))
+    return false;
+
+  int* base = reinterpret_cast<int*>(file.get()) + snapshot_header_ints;
+  info.resource.assign(base, base + m);
+  info.available.assign(base + stride, base + stride + m);
+  base += 2 * stride;
+
+  //Every matrix holds a pointer into the mapping that shares its reference count.
+  info.claim = matrix(shared_ptr<int>(file, base), n, m, stride);
+  info.allocation = matrix(shared_ptr<int>(file, base + rows), n, m, stride);
+  info.need = matrix(shared_ptr<int>(file, base + 2 * rows), n, m, stride);
+  info.request = info.need;
+  return true;
+}
+
+/********************************************
+Procedure Name: save_snapshot()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the snapshot file to be written.
+  - info = the state to be saved, its request matrix is taken to be its need matrix.
+  - n & m = number of processes and resources.
+
+Description:
+	Write info out in the snapshot format. Rows are written with their padding, zeroed,
+  so the file can be mapped and used without moving anything. Returns false if the file
+  can't be written.
+********************************************/
+bool save_snapshot(const char* path, const struct state& info, int n, int m)
+{
+  FILE* out = fopen(path, "wb");
+  if(out == NULL)
+    return false;
+
+  int stride = (m + cache_line_ints - 1) / cache_line_ints * cache_line_ints;
+  int header[snapshot_header_ints] = {0, snapshot_version, n, m, stride};
+  memcpy(header, snapshot_magic, 4);
+  fwrite(header, sizeof(int), snapshot_header_ints, out);
+
+  vector<int> row(stride, 0);
+  const vector<int>* vectors[2] = {&info.resource, &info.available};
+  for(int k = 0; k < 2; k++)
+  {
+    copy(vectors[k]->begin(), vectors[k]->begin() + m, row.begin());
+    fwrite(row.data(), sizeof(int), stride, out);
+  }
+
+  const matrix* mats[3] = {&info.claim, &info.allocation, &info.need};
+  for(int k = 0; k < 3; k++)
+  {
+    for(int i = 0; i < n; i++)
+    {
+      row_view r = mats[k]->row(i);
+      copy(r.begin(), r.end(), row.begin());
+      fwrite(row.data(), sizeof(int), stride, out);
+    }
+  }
+
+  bool ok = !ferror(out);
+  return fclose(out) == 0 && ok;
+}
+
+/********************************************
+Procedure Name: load_state()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the input file, text or snapshot.
+  - info = the state to be filled in.
+  - n & m = where the number of processes and resources are stored.
+
+Description:
+	Read a snapshot if the file starts with the snapshot magic number, otherwise read it
+  as text.
+********************************************/
+bool load_state(const char* path, struct state& info, int& n, int& m)
+{
+  char magic[4] = {0, 0, 0, 0};
+  FILE* in = fopen(path, "rb");
+  if(in == NULL)
+    return false;
+  size_t got = fread(magic, 1, 4, in);
+  fclose(in);
+
+  if(got == 4 && memcmp(magic, snapshot_magic, 4) == 0)
+    return load_snapshot(path, info, n, m);
+  return load_text(path, info, n, m);
+}
+
+#endif /* parser_h */
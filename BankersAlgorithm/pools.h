@@ -0,0 +1,571 @@
+/********************************************
+File Name: 			pools.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Struct:
+	 pool_demand - Part of a claim: up to this many units from anywhere under this node.
+
+Classes:
+	 resource_tree - Resources grouped into pools, such as sockets made of cores. The
+	                 leaves hold the units, every pool is the sum of what is under it.
+
+	 pool_state - The Banker's algorithm over a resource_tree. Processes claim and ask
+	              for units of pools, which are handed out from the leaves under them.
+
+Procedures: Members of the resource_tree class.
+
+int add_pool(int parent), int add_leaf(int parent, int units)
+    - Add a pool or a leaf holding units under parent, the root is node 0. Returns the
+      number of the new node.
+
+Procedures: Members of the pool_state class.
+
+pool_state(const resource_tree& tree)
+    - A state with every unit of tree available and no processes.
+
+int add_process(const vector<pool_demand>& claim)
+    - Add a process with the given claim and nothing held. Returns its number.
+
+int request(int p, int d, int units)
+    - Process p asks for units more towards demand d of its claim. Answers event_grant,
+      event_deny or event_error as in header.h.
+
+void release(int p)
+    - Process p gives back everything it holds.
+
+bool safe(vector<int>* sequence)
+    - Whether every process can run to completion, and in which order.
+
+int free_units(int v) const, const vector<pair<int, int> >& holding(int p) const
+    - The units available under node v, and the (leaf, units) handed out to process p.
+********************************************/
+
+#ifndef pools_h
+#define pools_h
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "header.h"
+
+using namespace std;
+
+/********************************************
+Structure Name: 		pool_demand
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        Part of the claim of a process: up to units units from any of the leaves under
+        node, the root standing for every resource.
+********************************************/
+struct pool_demand
+{
+  //the pool, or leaf, the units are to come from
+  int node;
+  //number of units
+  int units;
+};
+
+/********************************************
+Class Name: 		    resource_tree
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Resources grouped into pools. Node 0 is the root, every other node is a pool or a
+        leaf with a parent. Only the leaves hold units, the total of a pool is the sum
+        over the leaves under it.
+********************************************/
+class resource_tree
+{
+private:
+  //the parent of every node, -1 for the root
+  vector<int> up;
+  //the children of every node
+  vector<vector<int> > down;
+  //units under every node
+  vector<int> units;
+
+public:
+  resource_tree() : up(1, -1), down(1), units(1, 0) {}
+
+  int add_pool(int parent)
+  {
+    up.push_back(parent);
+    down.push_back(vector<int>());
+    units.push_back(0);
+    down[parent].push_back(up.size() - 1);
+    return up.size() - 1;
+  }
+
+  int add_leaf(int parent, int count)
+  {
+    int leaf = add_pool(parent);
+    for(int v = leaf; v != -1; v = up[v])
+    {
+      units[v] += count;
+    }
+    return leaf;
+  }
+
+  int size() const { return up.size(); }
+  int parent(int v) const { return up[v]; }
+  const vector<int>& children(int v) const { return down[v]; }
+  bool leaf(int v) const { return v != 0 && down[v].empty(); }
+  int total(int v) const { return units[v]; }
+};
+
+/********************************************
+Class Name: 		    pool_state
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        The Banker's algorithm over a resource_tree. The units a process still needs
+        can be handed out at once if and only if, at every node v, the needs of its
+        demands on v and the nodes under v add up to no more than what is available
+        under v: demands deeper in the tree have less choice and are met first, and the
+        pools above them take whatever is left. So the need of a process is kept as
+        those sums, one for every node on the paths from its demands up to the root,
+        and checked against the available units of every node, kept as aggregates that
+        are updated along the path to the root whenever units change hands. A check
+        never looks at the leaves a process has no demand on, so it doesn't grow with
+        the number of leaves.
+
+        Where the units of a grant are placed matters when the same process has other
+        demands below the pool asked from: units of a socket put on a core the process
+        also has a demand on leave that demand short. So units are placed in the room
+        left by the other demands of the process, and only spread over the rest when
+        there is no such room at all.
+
+        The safety check works like the incremental checker of safety.h. A process that
+        can't run waits on the first node it found short, and is only looked at again
+        once a finished process gives back units under that node. The lowest numbered
+        process that can run goes first.
+********************************************/
+class pool_state
+{
+private:
+  //the pools and leaves
+  const resource_tree* tree;
+  //units available under every node
+  vector<int> available;
+  //the claim of every process and the units of each demand granted so far
+  vector<vector<pool_demand> > claim;
+  vector<vector<int> > granted;
+  //(leaf, units) handed out to every process
+  vector<vector<pair<int, int> > > held;
+  //(node, units) still needed under every node on the paths from the demands of a process
+  vector<vector<pair<int, int> > > need;
+
+  //buffers for the safety check: units available during the check and the nodes changed
+  vector<int> work;
+  vector<int> touched;
+  //the processes waiting on every node, and the nodes that have any
+  vector<vector<int> > watchers;
+  vector<int> watched;
+  //processes that can run, a min-heap, and processes to be looked at again
+  vector<int> runnable;
+  vector<int> woken;
+  //sums per node while working out a need, and the nodes they are on
+  vector<int> sums;
+  vector<int> path;
+
+  void compute_need(int p);
+  int room(int v);
+  void take(int p, int node, int count);
+  void give_back(int leaf, int count, vector<int>& units);
+  bool try_run(int p);
+
+public:
+  pool_state(const resource_tree& t);
+
+  int add_process(const vector<pool_demand>& demands);
+
+  int request(int p, int d, int units);
+
+  void release(int p);
+
+  bool safe(vector<int>* sequence = NULL);
+
+  int free_units(int v) const { return available[v]; }
+  const vector<pair<int, int> >& holding(int p) const { return held[p]; }
+};
+
+/********************************************
+Procedure Name: pool_state()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - t = the pools and leaves, they have to outlive the state.
+
+Description:
+	The constructor for the pool_state class. Every unit is available.
+********************************************/
+pool_state::pool_state(const resource_tree& t)
+  : tree(&t), available(t.size()), work(t.size()), watchers(t.size()), sums(t.size(), 0)
+{
+  for(int v = 0; v < t.size(); v++)
+  {
+    available[v] = work[v] = t.total(v);
+  }
+}
+
+/********************************************
+Procedure Name: compute_need()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process whose need is to be worked out.
+
+Description:
+	Add the units each demand of p still needs to every node from the demand up to the
+  root, and keep the nonzero sums.
+********************************************/
+void pool_state::compute_need(int p)
+{
+  path.clear();
+  for(size_t d = 0; d < claim[p].size(); d++)
+  {
+    int left = claim[p][d].units - granted[p][d];
+    if(left == 0)
+      continue;
+    for(int v = claim[p][d].node; v != -1; v = tree->parent(v))
+    {
+      if(sums[v] == 0)
+        path.push_back(v);
+      sums[v] += left;
+    }
+  }
+
+  //Deepest first is as good an order as any, the root is usually the last to run short.
+  need[p].clear();
+  for(size_t k = 0; k < path.size(); k++)
+  {
+    need[p].push_back(make_pair(path[k], sums[path[k]]));
+    sums[path[k]] = 0;
+  }
+}
+
+/********************************************
+Procedure Name: add_process()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - demands = the claim of the new process.
+
+Description:
+	Add a process holding nothing. Returns its number.
+********************************************/
+int pool_state::add_process(const vector<pool_demand>& demands)
+{
+  int p = claim.size();
+  claim.push_back(demands);
+  granted.push_back(vector<int>(demands.size(), 0));
+  held.push_back(vector<pair<int, int> >());
+  need.push_back(vector<pair<int, int> >());
+  compute_need(p);
+  return p;
+}
+
+/********************************************
+Procedure Name: room()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - v = the node to be looked at.
+
+Description:
+	The units that can be taken under v and still leave the demands of the process being
+  granted at v and under it what they need, with those needs set in sums by take(). A
+  node without such demands under it has all of its available units to spare, so only
+  the nodes on the paths of the demands are looked into.
+********************************************/
+int pool_state::room(int v)
+{
+  if(sums[v] == 0)
+    return available[v];
+  int r = available[v] - sums[v];
+  if(r <= 0 || tree->leaf(v))
+    return max(r, 0);
+  int below = 0;
+  const vector<int>& c = tree->children(v);
+  for(size_t k = 0; k < c.size() && below < r; k++)
+  {
+    below += room(c[k]);
+  }
+  return min(r, below);
+}
+
+/********************************************
+Procedure Name: take()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process the units are handed to.
+  - node = the pool they are to come from, with at least count units available.
+  - count = number of units.
+
+Description:
+	Hand count units under node to p. At every level they are taken from the child with
+  the most room left by the other demands of p, see room(), so that they aren't left
+  short, and among children with the same room from the one with the most available,
+  so what is left stays spread out. On a tree taking the most that fits along one path
+  at a time places as much as can be placed in that room. Once there is none the rest
+  is taken from the children with the most available.
+********************************************/
+void pool_state::take(int p, int node, int count)
+{
+  //The needs of p on every node, those under node are what has to be left room for.
+  for(size_t k = 0; k < need[p].size(); k++)
+  {
+    sums[need[p][k].first] = need[p][k].second;
+  }
+  bool spare = true;
+
+  while(count > 0)
+  {
+    //Walk down to a leaf along the children with the most room, or available.
+    int v = node;
+    int units = count;
+    while(!tree->leaf(v))
+    {
+      const vector<int>& c = tree->children(v);
+      int best = c[0];
+      int most = spare ? room(best) : available[best];
+      for(size_t k = 1; k < c.size(); k++)
+      {
+        int r = spare ? room(c[k]) : available[c[k]];
+        if(r > most || (r == most && available[c[k]] > available[best]))
+        {
+          best = c[k];
+          most = r;
+        }
+      }
+      if(most == 0 && spare)
+      {
+        //No room is left anywhere under node, start again over what is available.
+        spare = false;
+        v = node;
+        units = count;
+        continue;
+      }
+      v = best;
+      units = min(units, most);
+    }
+
+    units = min(units, available[v]);
+    held[p].push_back(make_pair(v, units));
+    for(int u = v; u != -1; u = tree->parent(u))
+    {
+      available[u] -= units;
+      work[u] -= units;
+    }
+    count -= units;
+  }
+
+  for(size_t k = 0; k < need[p].size(); k++)
+  {
+    sums[need[p][k].first] = 0;
+  }
+}
+
+/********************************************
+Procedure Name: give_back()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - leaf = the leaf the units came from.
+  - count = number of units.
+  - units = the aggregates to add them to, available or work.
+
+Description:
+	Add count units back to leaf and every pool above it.
+********************************************/
+void pool_state::give_back(int leaf, int count, vector<int>& units)
+{
+  for(int u = leaf; u != -1; u = tree->parent(u))
+  {
+    units[u] += count;
+  }
+}
+
+/********************************************
+Procedure Name: request()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process asking.
+  - d = the demand of its claim the units are for.
+  - units = number of units asked for.
+
+Description:
+	A request over what is left of the demand is an error, one over what is available
+  under the pool is denied. Otherwise the units are handed out, and taken back and the
+  request denied if the state is then unsafe.
+********************************************/
+int pool_state::request(int p, int d, int units)
+{
+  if(p < 0 || p >= (int)claim.size() || d < 0 || d >= (int)claim[p].size() || units < 0)
+    return event_error;
+  pool_demand demand = claim[p][d];
+  if(units > demand.units - granted[p][d])
+    return event_error;
+  if(units > available[demand.node])
+    return event_deny;
+
+  size_t mark = held[p].size();
+  take(p, demand.node, units);
+  granted[p][d] += units;
+  compute_need(p);
+  if(safe())
+    return event_grant;
+
+  //Roll the grant back.
+  for(size_t k = mark; k < held[p].size(); k++)
+  {
+    give_back(held[p][k].first, held[p][k].second, available);
+    give_back(held[p][k].first, held[p][k].second, work);
+  }
+  held[p].resize(mark);
+  granted[p][d] -= units;
+  compute_need(p);
+  return event_deny;
+}
+
+/********************************************
+Procedure Name: release()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process giving its units back.
+
+Description:
+	Process p gives back everything it holds, its claim stays as it was.
+********************************************/
+void pool_state::release(int p)
+{
+  for(size_t k = 0; k < held[p].size(); k++)
+  {
+    give_back(held[p][k].first, held[p][k].second, available);
+    give_back(held[p][k].first, held[p][k].second, work);
+  }
+  held[p].clear();
+  fill(granted[p].begin(), granted[p].end(), 0);
+  compute_need(p);
+}
+
+/********************************************
+Procedure Name: try_run()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process to be looked at.
+
+Description:
+	Returns true if the need of p can be met from work, otherwise leaves p waiting on the
+  first node that is short.
+********************************************/
+bool pool_state::try_run(int p)
+{
+  for(size_t k = 0; k < need[p].size(); k++)
+  {
+    int v = need[p][k].first;
+    if(need[p][k].second > work[v])
+    {
+      if(watchers[v].empty())
+        watched.push_back(v);
+      watchers[v].push_back(p);
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************************
+Procedure Name: safe()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - sequence = where the order the processes can run in is stored, if not NULL.
+
+Description:
+	The Banker's algorithm over the tree. Every process is tried once. When one runs, the
+  units it holds go back to their leaves and the pools above them, and the processes
+  waiting on any of those nodes are tried again. The nodes changed are put back the way
+  they were at the end, so a check costs nothing for the parts of the tree it doesn't
+  touch.
+********************************************/
+bool pool_state::safe(vector<int>* sequence)
+{
+  int n = claim.size();
+  int left = n;
+  if(sequence != NULL)
+    sequence->clear();
+
+  runnable.clear();
+  for(int p = 0; p < n; p++)
+  {
+    if(try_run(p))
+      runnable.push_back(p);
+  }
+
+  while(!runnable.empty())
+  {
+    pop_heap(runnable.begin(), runnable.end(), greater<int>());
+    int p = runnable.back();
+    runnable.pop_back();
+    left--;
+    if(sequence != NULL)
+      sequence->push_back(p);
+
+    //Give back what p holds and wake whoever waits on the nodes it lands on.
+    woken.clear();
+    for(size_t k = 0; k < held[p].size(); k++)
+    {
+      for(int u = held[p][k].first; u != -1; u = tree->parent(u))
+      {
+        work[u] += held[p][k].second;
+        touched.push_back(u);
+        if(!watchers[u].empty())
+        {
+          woken.insert(woken.end(), watchers[u].begin(), watchers[u].end());
+          watchers[u].clear();
+        }
+      }
+    }
+    for(size_t k = 0; k < woken.size(); k++)
+    {
+      if(try_run(woken[k]))
+      {
+        runnable.push_back(woken[k]);
+        push_heap(runnable.begin(), runnable.end(), greater<int>());
+      }
+    }
+  }
+
+  //Put the nodes changed back and drop whoever is still waiting.
+  for(size_t k = 0; k < touched.size(); k++)
+  {
+    work[touched[k]] = available[touched[k]];
+  }
+  touched.clear();
+  for(size_t k = 0; k < watched.size(); k++)
+  {
+    watchers[watched[k]].clear();
+  }
+  watched.clear();
+
+  return left == 0;
+}
+
+#endif /* pools_h */
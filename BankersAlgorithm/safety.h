@@ -0,0 +1,388 @@
+/********************************************
+File Name: 			safety.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Classes:
+	 rescan_checker - The original safety scan. After every finished process the list of
+	                  remaining processes is scanned again from the start, O(n^2 * m).
+
+	 simd_checker - The rescan with each row compared against the available vector by the
+	                widest packed compare kernel the CPU supports (see kernel.h).
+
+	 incremental_checker - A safety scan that keeps, for every resource, the waiting
+	                       processes sorted by their need for it and, for every process, the
+	                       number of resources it is still waiting on. Only the processes
+	                       that become runnable when the available vector grows are looked
+	                       at, O(n * m * log n).
+
+	 adaptive_checker - The packed compare rescan until it has skipped rescan_budget rows per
+	                    process, then the incremental checker over whatever is left.
+
+The last two are basic_incremental_checker<0> and basic_adaptive_checker<0>. With M > 0 the
+same classes take the number of resources to be M, so every loop over the resources has a
+constant trip count and rows are compared with row_le_fixed<M> (see fixed.h).
+
+All checkers have the same members and pick the same process at every step: the first
+process in the given order whose need can be met by the currently available resources.
+
+Procedures: Members of the checker classes.
+
+void start(const matrix& need, const matrix& allocation, const vector<int>& available,
+           const vector<int>& order, int m)
+    - Set up a check of the processes in order. The matrices are read as the check goes, so
+      they have to outlive it.
+
+int next()
+    - Simulate the next process running to completion, release its allocation and return
+      its number. Returns -1 when no remaining process can run.
+
+int remaining() const
+    - The number of processes that haven't been run yet.
+
+const vector<int>& current_available() const
+    - The resources available after the processes returned so far have finished.
+********************************************/
+
+#ifndef safety_h
+#define safety_h
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+
+#include "matrix.h"
+#include "kernel.h"
+#include "metrics.h"
+
+using namespace std;
+
+/* Macro denoting the rows per process adaptive_checker's rescan may pass over before the
+   incremental checker takes over */
+#define rescan_budget 8
+
+/********************************************
+Class Name: 		    rescan_checker
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        The safety scan as it was first written in safe(). Kept as the reference the
+        other checkers are compared against.
+********************************************/
+class rescan_checker
+{
+protected:
+  //the kernel used to compare a need row with the available vector
+  row_le_fn le;
+
+private:
+  //the need and allocation matrices of the state being checked
+  const matrix* need;
+  const matrix* allocation;
+  //number of resources
+  int m;
+  //the processes that haven't been run yet, in order
+  vector<int> rest;
+  //the resources available at this point of the simulation
+  vector<int> available;
+  //rows passed over by next() since start()
+  long long skips;
+
+public:
+  rescan_checker(row_le_fn kernel = row_le_scalar) : le(kernel) {}
+
+  void start(const matrix& nd, const matrix& a, const vector<int>& avail,
+             const vector<int>& ord, int res)
+  {
+    need = &nd;
+    allocation = &a;
+    m = res;
+    rest = ord;
+    available = avail;
+    skips = 0;
+  }
+
+  int next()
+  {
+    vector<int>::iterator it;
+    //Find the first process in rest s.t. claim - allocation <= available resources
+    for(it = rest.begin(); it != rest.end(); ++it)
+    {
+      if(le(need->row(*it).data, available.data(), m))
+        break;
+    }
+    count_metric(metric_rows_scanned, it - rest.begin() + (it != rest.end()));
+    skips += it - rest.begin();
+
+    if(it == rest.end())
+      return -1;
+
+    //Simulate the process finishing and releasing what it holds.
+    int p = *it;
+    row_view a = allocation->row(p);
+    for(int i = 0; i < m; i++)
+    {
+      available[i] += a[i];
+    }
+    rest.erase(it);
+    return p;
+  }
+
+  int remaining() const { return rest.size(); }
+  const vector<int>& current_available() const { return available; }
+  //The processes not run yet, in order, and how many rows next() has passed over so far.
+  const vector<int>& rest_order() const { return rest; }
+  long long skipped() const { return skips; }
+};
+
+/********************************************
+Class Name: 		    simd_checker
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	None.
+
+Description:
+        The rescan with each need row compared against the available vector by row_le,
+        the widest packed compare kernel picked at start up.
+********************************************/
+class simd_checker : public rescan_checker
+{
+public:
+  simd_checker() : rescan_checker(row_le) {}
+};
+
+/********************************************
+Class Name: 		    basic_incremental_checker
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        A safety scan that never rescans the list of processes. Processes are referred
+        to by their position k in the order given to start(). For every resource j the
+        positions whose need for j is more than what is available are kept sorted by that
+        need, and unsatisfied[k] counts the resources position k is still waiting on.
+        When a process finishes, only the resources it releases are looked at and the
+        sorted lists are advanced past the needs that can now be met. A position whose
+        count drops to zero is runnable and goes on a min-heap, so the lowest runnable
+        position is always picked, same as the rescan. Rows that can run straight away
+        are found with the row_le kernel and never go into the sorted lists.
+
+        M is the number of resources if it is known at compile time and 0 otherwise,
+        when the m given to start() is used.
+********************************************/
+template <int M>
+class basic_incremental_checker
+{
+private:
+  //the need and allocation matrices of the state being checked
+  const matrix* need;
+  const matrix* allocation;
+  //number of resources
+  int m;
+  //the processes in the order they are to be considered
+  vector<int> order;
+  //the resources available at this point of the simulation
+  vector<int> available;
+  //number of resources each position is still waiting on
+  vector<int> unsatisfied;
+  //(need, position) pairs waiting on each resource, sorted by need, resource j is [first[j], last[j])
+  vector<pair<int, int> > waiting;
+  vector<int> first;
+  vector<int> last;
+  //positions whose needs can all be met, a min-heap so the lowest is first
+  vector<int> runnable;
+  //number of processes not run yet
+  int left;
+
+  //The number of resources, a constant the loops unroll on when M is given.
+  int cols() const { return M > 0 ? M : m; }
+
+  //Whether need row r can be met by what is available.
+  bool fits(const int* r) const
+  {
+    return M > 0 ? row_le_fixed<M>(r, available.data(), M) : row_le(r, available.data(), m);
+  }
+
+  //Move the sorted list of resource j past every need that can now be met.
+  void wake(int j)
+  {
+    while(first[j] < last[j] && waiting[first[j]].first <= available[j])
+    {
+      if(--unsatisfied[waiting[first[j]].second] == 0)
+      {
+        runnable.push_back(waiting[first[j]].second);
+        push_heap(runnable.begin(), runnable.end(), greater<int>());
+      }
+      first[j]++;
+    }
+  }
+
+public:
+  void start(const matrix& nd, const matrix& a, const vector<int>& avail,
+             const vector<int>& ord, int res)
+  {
+    need = &nd;
+    allocation = &a;
+    m = res;
+    order = ord;
+    available = avail;
+    left = order.size();
+    //Buffers are only cleared, so a checker kept between checks stops allocating.
+    runnable.clear();
+
+    int n = order.size();
+    unsatisfied.assign(n, 0);
+    first.assign(cols() + 1, 0);
+    last.assign(cols(), 0);
+    count_metric(metric_rows_scanned, n);
+
+    //Count the positions waiting on each resource ...
+    for(int k = 0; k < n; k++)
+    {
+      row_view nr = need->row(order[k]);
+      if(fits(nr.data))
+      {
+        //Pushed in increasing order, which is already a min-heap.
+        runnable.push_back(k);
+        continue;
+      }
+      for(int j = 0; j < cols(); j++)
+      {
+        if(nr[j] > available[j])
+        {
+          unsatisfied[k]++;
+          first[j + 1]++;
+        }
+      }
+    }
+
+    //... lay the lists out one after another in the waiting buffer ...
+    for(int j = 0; j < cols(); j++)
+    {
+      first[j + 1] += first[j];
+      last[j] = first[j];
+    }
+    waiting.resize(first[cols()]);
+
+    //... fill them in and sort each one by need.
+    for(int k = 0; k < n; k++)
+    {
+      if(unsatisfied[k] == 0)
+        continue;
+      row_view nr = need->row(order[k]);
+      for(int j = 0; j < cols(); j++)
+      {
+        if(nr[j] > available[j])
+          waiting[last[j]++] = make_pair(nr[j], k);
+      }
+    }
+    for(int j = 0; j < cols(); j++)
+    {
+      sort(waiting.begin() + first[j], waiting.begin() + last[j]);
+    }
+  }
+
+  int next()
+  {
+    if(runnable.empty())
+      return -1;
+
+    pop_heap(runnable.begin(), runnable.end(), greater<int>());
+    int p = order[runnable.back()];
+    runnable.pop_back();
+    left--;
+
+    //Release the allocation and wake whoever was waiting on the resources released.
+    row_view a = allocation->row(p);
+    for(int j = 0; j < cols(); j++)
+    {
+      if(a[j] != 0)
+      {
+        available[j] += a[j];
+        wake(j);
+      }
+    }
+    return p;
+  }
+
+  int remaining() const { return left; }
+  const vector<int>& current_available() const { return available; }
+};
+
+typedef basic_incremental_checker<0> incremental_checker;
+
+/********************************************
+Class Name: 		    basic_adaptive_checker
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        The checker used by safe(). On most states the next process to run is near the
+        front of the list, so the rescan does little more than one row compare per step
+        and is several times faster than building the sorted lists of the incremental
+        checker. When the rescan keeps passing over rows that can't run, as with a chain
+        where each process waits on the one after it, it costs O(n^2 * m). So the rescan
+        runs until it has passed over rescan_budget rows per process checked, and then
+        the incremental checker takes the processes left, in the same order and with the
+        resources available at that point, and picks the same process the rescan would.
+        With M > 0 both compare rows with row_le_fixed<M>.
+********************************************/
+template <int M>
+class basic_adaptive_checker
+{
+private:
+  //the rescan, used first
+  rescan_checker scan;
+  //the incremental checker, used once the rescan is over budget
+  basic_incremental_checker<M> sorted;
+  //whether the incremental checker has taken over
+  bool switched;
+  //the rows the rescan may pass over before it hands over
+  long long budget;
+  //the need and allocation matrices of the state being checked
+  const matrix* need;
+  const matrix* allocation;
+  //number of resources
+  int m;
+
+public:
+  basic_adaptive_checker() : scan(M > 0 ? row_le_fixed<M> : row_le) {}
+
+  void start(const matrix& nd, const matrix& a, const vector<int>& avail,
+             const vector<int>& ord, int res)
+  {
+    need = &nd;
+    allocation = &a;
+    m = res;
+    switched = false;
+    budget = (long long)rescan_budget * ord.size();
+    scan.start(nd, a, avail, ord, res);
+  }
+
+  int next()
+  {
+    if(!switched)
+    {
+      if(scan.skipped() <= budget)
+        return scan.next();
+      sorted.start(*need, *allocation, scan.current_available(), scan.rest_order(), m);
+      switched = true;
+    }
+    return sorted.next();
+  }
+
+  int remaining() const { return switched ? sorted.remaining() : scan.remaining(); }
+  const vector<int>& current_available() const { return switched ? sorted.current_available() : scan.current_available(); }
+};
+
+typedef basic_adaptive_checker<0> adaptive_checker;
+
+#endif /* safety_h */
@@ -0,0 +1,791 @@
+/********************************************
+File Name: 			sequences.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Classes:
+	 memo_table - A hash table from a set of finished processes to what is known about
+	              the processes left, split in shards with a lock each so every thread
+	              can use it.
+
+	 sequence_search - Counts the safe sequences of a state, or finds the best k of them
+	                   under a cost, by a search over the sets of finished processes.
+
+Procedures:
+
+string count_text(seq_count c)
+    - The decimal digits of a count of sequences.
+
+Procedures: Members of the sequence_search class.
+
+sequence_search(const state& s, int n, int m)
+    - Set up the search of the safe sequences of s, at most 64 processes.
+
+void set_budget(double seconds)
+    - Stop searching after this long, 0 for no limit.
+
+seq_count count(thread_pool* pool)
+    - The number of safe sequences.
+
+vector<ranked_sequence> best(int k, int cost)
+    - The k safe sequences of least cost, cheapest first.
+
+bool complete() const
+    - False if the last search was cut short by the time budget.
+********************************************/
+
+#ifndef sequences_h
+#define sequences_h
+
+#include <stdint.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "header.h"
+#include "threadpool.h"
+
+using namespace std;
+
+/* Costs a sequence can be ranked by */
+#define cost_peak 0
+#define cost_wait 1
+
+/* Number of shards of a memo_table */
+#define memo_shards 64
+
+/* Sets of finished processes smaller than this are split into tasks for other threads */
+#define search_spawn_depth 3
+
+/* A number of sequences, up to 34! fits, larger counts stop at seq_count_max */
+typedef unsigned __int128 seq_count;
+#define seq_count_max (~(seq_count)0)
+
+/********************************************
+Structure Name: 		ranked_sequence
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        A safe sequence and its cost.
+********************************************/
+struct ranked_sequence
+{
+  //the cost of the sequence
+  long long cost;
+  //the processes in the order they run to completion
+  vector<int> order;
+};
+
+/********************************************
+Procedure Name: count_text()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - c = the count to be printed.
+
+Description:
+	The decimal digits of c, which iostream can't print by itself.
+********************************************/
+string count_text(seq_count c)
+{
+  string digits;
+  do
+  {
+    digits += (char)('0' + (int)(c % 10));
+    c /= 10;
+  } while(c != 0);
+  reverse(digits.begin(), digits.end());
+  return digits;
+}
+
+/********************************************
+Class Name: 		    memo_table
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        A hash table from the bitset of finished processes to a value, split in
+        memo_shards shards by the hash of the key. Every shard has its own lock, so
+        threads working on different parts of the search rarely wait on each other.
+        A shard is an open addressed table with linear probing, keys and values side
+        by side, so a lookup in a table far larger than the cache is one miss rather
+        than one for the bucket and one for the node. It doubles when half full. The
+        set of all processes is never stored, so all ones marks a free slot.
+********************************************/
+template <class V>
+class memo_table
+{
+private:
+  struct shard
+  {
+    mutex mtx;
+    vector<pair<uint64_t, V> > slots;
+    size_t used;
+  };
+  shard shards[memo_shards];
+
+  static uint64_t mix_key(uint64_t x)
+  {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    return x;
+  }
+
+  //The slot of key in s, or the free slot it would go in.
+  static size_t probe(const shard& s, uint64_t key, uint64_t h)
+  {
+    size_t mask = s.slots.size() - 1;
+    size_t i = (h / memo_shards) & mask;
+    while(s.slots[i].first != key && s.slots[i].first != ~0ULL)
+    {
+      i = (i + 1) & mask;
+    }
+    return i;
+  }
+
+  static void grow(shard& s)
+  {
+    vector<pair<uint64_t, V> > old(max((size_t)16, s.slots.size() * 2), make_pair(~0ULL, V()));
+    old.swap(s.slots);
+    for(size_t i = 0; i < old.size(); i++)
+    {
+      if(old[i].first != ~0ULL)
+        s.slots[probe(s, old[i].first, mix_key(old[i].first))] = old[i];
+    }
+  }
+
+public:
+  memo_table()
+  {
+    for(int i = 0; i < memo_shards; i++)
+    {
+      shards[i].used = 0;
+      grow(shards[i]);
+    }
+  }
+
+  bool find(uint64_t key, V& value)
+  {
+    uint64_t h = mix_key(key);
+    shard& s = shards[h % memo_shards];
+    lock_guard<mutex> lock(s.mtx);
+    const pair<uint64_t, V>& slot = s.slots[probe(s, key, h)];
+    if(slot.first != key)
+      return false;
+    value = slot.second;
+    return true;
+  }
+
+  //Store value unless key is there already, returns true if it was stored.
+  bool insert(uint64_t key, const V& value)
+  {
+    uint64_t h = mix_key(key);
+    shard& s = shards[h % memo_shards];
+    lock_guard<mutex> lock(s.mtx);
+    size_t i = probe(s, key, h);
+    if(s.slots[i].first == key)
+      return false;
+    s.slots[i] = make_pair(key, value);
+    if(++s.used * 2 > s.slots.size())
+      grow(s);
+    return true;
+  }
+
+  void clear()
+  {
+    for(int i = 0; i < memo_shards; i++)
+    {
+      shards[i].slots.clear();
+      shards[i].used = 0;
+      grow(shards[i]);
+    }
+  }
+
+  size_t size()
+  {
+    size_t total = 0;
+    for(int i = 0; i < memo_shards; i++)
+    {
+      lock_guard<mutex> lock(shards[i].mtx);
+      total += shards[i].used;
+    }
+    return total;
+  }
+};
+
+/********************************************
+Class Name: 		    sequence_search
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        What is left to do after some processes have finished depends only on which
+        ones they were: the available vector is then the one read in plus their
+        allocations, whatever order they ran in. So the number of safe sequences, or
+        the best few of them, is worked out once for every set of finished processes,
+        held as a 64 bit bitset, and kept in a memo_table.
+
+        A process that can run stays able to run as the available vector only grows,
+        so if the state read in is safe, every set reached by running processes that
+        can run is safe as well. The state is checked once up front and then the search
+        never meets a dead end. A set where every process left can run has (n - |S|)!
+        sequences and is not looked into any further when counting.
+
+        With more than one thread, the sets of fewer than search_spawn_depth finished
+        processes are not solved but split into one task for every process that can
+        run next. Every thread keeps its own deque of tasks, takes from its back and,
+        when it runs dry, steals from the front of the others. Tasks that deep are
+        solved with the memoised search, sharing the table, and the sets above them
+        are solved last from what the table holds. Only counting is split up this way.
+        The search for the best sequences skips most sets with its bound (see
+        best_from()), and splitting it would solve sets the bound never lets it
+        reach, so it runs on one thread.
+
+        Costs, with S the set that has finished before process p runs:
+          cost_peak: the most units in use at once, counting every unit held by the
+                     processes not finished yet and the units p still needs.
+          cost_wait: the total time processes wait before they start, every process
+                     taking as long as the units it claims (at least 1).
+
+        With a time budget, once it is spent no new set is looked into except the
+        first (cheapest) process at every step, so there is always an answer. The
+        count is then a lower bound, the sequences are real but maybe not the best,
+        and complete() returns false.
+********************************************/
+class sequence_search
+{
+private:
+  //the first process to run, the cost of the sequence, and which of the best
+  //sequences of the set with that process added follows it
+  struct link
+  {
+    long long cost;
+    int p;
+    int rank;
+  };
+  //what is known about a set of finished processes, partial if the budget ran out on it
+  struct counted
+  {
+    seq_count count;
+    bool partial;
+  };
+  //the best sequences of a set, shared between the memo table and whoever reads them
+  typedef shared_ptr<const vector<link> > link_list;
+  struct ranked
+  {
+    link_list best;
+    bool partial;
+  };
+
+  //the state read in
+  int n, m;
+  matrix need, allocation;
+  vector<int> available;
+  //units of all resources together, and the time every process takes
+  long long units;
+  vector<long long> length;
+  //0! ... 64!, saturated at the largest seq_count
+  vector<seq_count> factorial;
+  //whether the state read in is safe
+  bool safe_state;
+  //the one sequence of the set of all processes, the empty one
+  link_list finished;
+
+  //what is searched for
+  int k, cost;
+  //the memo tables, and the sets already handed out as tasks
+  memo_table<counted> counts;
+  memo_table<ranked> ranks;
+  memo_table<char> spawned;
+
+  //the time budget
+  double budget;
+  chrono::steady_clock::time_point deadline;
+  atomic<bool> late;
+
+  bool out_of_time()
+  {
+    if(late.load(memory_order_relaxed))
+      return true;
+    if(budget > 0 && chrono::steady_clock::now() > deadline)
+      late = true;
+    return late.load(memory_order_relaxed);
+  }
+
+  static seq_count saturate_add(seq_count a, seq_count b)
+  {
+    seq_count r = a + b;
+    return r < a ? seq_count_max : r;
+  }
+
+  //The available vector once the processes in done have finished.
+  void available_after(uint64_t done, vector<int>& avail) const
+  {
+    avail = available;
+    for(int p = 0; p < n; p++)
+    {
+      if(done >> p & 1)
+      {
+        row_view a = allocation.row(p);
+        for(int j = 0; j < m; j++)
+        {
+          avail[j] += a[j];
+        }
+      }
+    }
+  }
+
+  //The processes not in done that can run with avail, in increasing order.
+  int runnable(uint64_t done, const vector<int>& avail, int* run) const
+  {
+    int count = 0;
+    for(int p = 0; p < n; p++)
+    {
+      if(!(done >> p & 1) && row_le(need.row(p).data, avail.data(), m))
+        run[count++] = p;
+    }
+    return count;
+  }
+
+  //Add the allocation of p to avail, or take it off again.
+  void release(int p, int sign, vector<int>& avail) const
+  {
+    row_view a = allocation.row(p);
+    for(int j = 0; j < m; j++)
+    {
+      avail[j] += sign * a[j];
+    }
+  }
+
+  //The cost of running p next when left processes haven't finished, before it is combined.
+  long long step_cost(int p, int left, const vector<int>& avail) const
+  {
+    if(cost == cost_wait)
+      return length[p] * (left - 1);
+    long long in_use = units;
+    row_view nd = need.row(p);
+    for(int j = 0; j < m; j++)
+    {
+      in_use += nd[j] - avail[j];
+    }
+    return in_use;
+  }
+
+  long long combine(long long step, long long rest) const
+  {
+    return cost == cost_wait ? step + rest : max(step, rest);
+  }
+
+  seq_count count_from(uint64_t done, int left, vector<int>& avail, bool& partial);
+  link_list best_from(uint64_t done, int left, vector<int>& avail, bool& partial);
+  void solve(uint64_t done, bool& partial);
+  void search(thread_pool* pool, bool& partial);
+
+public:
+  sequence_search(const state& s, int n, int m);
+
+  void set_budget(double seconds) { budget = seconds; }
+
+  seq_count count(thread_pool* pool = NULL);
+  vector<ranked_sequence> best(int k, int cost);
+
+  bool complete() const { return !late.load(); }
+  size_t memo_size() { return counts.size() + ranks.size(); }
+};
+
+/********************************************
+Procedure Name: sequence_search()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - s = the state whose safe sequences are searched for.
+  - n & m = number of processes and resources, n at most 64.
+
+Description:
+	Keep the need and allocation matrices of s, work out the units and time of every
+  process and check once whether s is safe at all.
+********************************************/
+sequence_search::sequence_search(const state& s, int n, int m)
+  : n(n), m(m), need(s.need), allocation(s.allocation), available(s.available),
+    units(0), length(n), factorial(65), k(1), cost(cost_peak), budget(0), late(false)
+{
+  for(int j = 0; j < m; j++)
+  {
+    units += s.resource[j];
+  }
+  for(int p = 0; p < n; p++)
+  {
+    row_view nd = need.row(p);
+    row_view a = allocation.row(p);
+    length[p] = 0;
+    for(int j = 0; j < m; j++)
+    {
+      length[p] += nd[j] + a[j];
+    }
+    length[p] = max(length[p], 1LL);
+  }
+  factorial[0] = 1;
+  for(int i = 1; i <= 64; i++)
+  {
+    seq_count f = factorial[i - 1] * i;
+    factorial[i] = f / i != factorial[i - 1] ? seq_count_max : f;
+  }
+
+  vector<int> order(n);
+  for(int p = 0; p < n; p++)
+  {
+    order[p] = p;
+  }
+  adaptive_checker c;
+  c.start(need, allocation, available, order, m);
+  while(c.next() != -1);
+  safe_state = c.remaining() == 0;
+
+  link end = {0, -1, -1};
+  finished = make_shared<const vector<link> >(1, end);
+}
+
+/********************************************
+Procedure Name: count_from()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - done = the set of processes that have finished.
+  - left = the number of processes that haven't.
+  - avail = the available vector after done, put back as it was on return.
+  - partial = set if the count is cut short by the time budget.
+
+Description:
+	The number of safe sequences of the processes not in done, the sum of those after
+  every process that can run next. Memoised on done.
+********************************************/
+seq_count sequence_search::count_from(uint64_t done, int left, vector<int>& avail, bool& partial)
+{
+  if(left == 0)
+    return 1;
+  counted known;
+  if(counts.find(done, known))
+  {
+    partial |= known.partial;
+    return known.count;
+  }
+
+  int run[64];
+  int r = runnable(done, avail, run);
+  //Every order of the processes left is safe.
+  if(r == left)
+    return factorial[left];
+
+  seq_count total = 0;
+  bool cut = false;
+  for(int i = 0; i < r; i++)
+  {
+    if(i > 0 && out_of_time())
+    {
+      cut = true;
+      break;
+    }
+    release(run[i], 1, avail);
+    total = saturate_add(total, count_from(done | 1ULL << run[i], left - 1, avail, cut));
+    release(run[i], -1, avail);
+  }
+
+  counted result = {total, cut};
+  counts.insert(done, result);
+  partial |= cut;
+  return total;
+}
+
+/********************************************
+Procedure Name: best_from()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Same as count_from().
+
+Description:
+	The k cheapest safe sequences of the processes not in done, as links to the sets
+  after them. The candidates are every process that can run next followed by one of
+  the k best sequences after it, since a cheaper rest never makes a sequence dearer.
+  Processes are tried cheapest step first, so the first sequence found is the greedy
+  one, and the rest are skipped once their step alone costs more than k candidates.
+  Ties are broken by process and rank. Memoised on done.
+********************************************/
+sequence_search::link_list sequence_search::best_from(uint64_t done, int left, vector<int>& avail, bool& partial)
+{
+  if(left == 0)
+    return finished;
+  ranked known;
+  if(ranks.find(done, known))
+  {
+    partial |= known.partial;
+    return known.best;
+  }
+
+  int run[64];
+  int r = runnable(done, avail, run);
+  pair<long long, int> steps[64];
+  for(int i = 0; i < r; i++)
+  {
+    steps[i] = make_pair(step_cost(run[i], left, avail), run[i]);
+  }
+  sort(steps, steps + r);
+
+  vector<link> candidates;
+  vector<long long> costs;
+  bool cut = false;
+  for(int i = 0; i < r; i++)
+  {
+    //A sequence costs at least its first step, so once k candidates cost less than this
+    //step and the ones after it, none of them can make the k best.
+    if((int)candidates.size() >= k)
+    {
+      costs.clear();
+      for(size_t j = 0; j < candidates.size(); j++)
+      {
+        costs.push_back(candidates[j].cost);
+      }
+      nth_element(costs.begin(), costs.begin() + (k - 1), costs.end());
+      if(steps[i].first > costs[k - 1])
+        break;
+    }
+    if(i > 0 && out_of_time())
+    {
+      cut = true;
+      break;
+    }
+    int p = steps[i].second;
+    release(p, 1, avail);
+    link_list rest = best_from(done | 1ULL << p, left - 1, avail, cut);
+    release(p, -1, avail);
+    for(size_t j = 0; j < rest->size(); j++)
+    {
+      link l = {combine(steps[i].first, (*rest)[j].cost), p, (int)j};
+      candidates.push_back(l);
+    }
+  }
+
+  //Keep the k cheapest.
+  int keep = min((int)candidates.size(), k);
+  partial_sort(candidates.begin(), candidates.begin() + keep, candidates.end(), [](const link& a, const link& b)
+  {
+    if(a.cost != b.cost)
+      return a.cost < b.cost;
+    return a.p != b.p ? a.p < b.p : a.rank < b.rank;
+  });
+  candidates.resize(keep);
+
+  //If another thread got there first, its answer is the one the links will follow.
+  ranked result = {make_shared<const vector<link> >(candidates), cut};
+  if(!ranks.insert(done, result))
+    ranks.find(done, result);
+  partial |= result.partial;
+  return result.best;
+}
+
+/********************************************
+Procedure Name: solve()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - done = a set of finished processes.
+  - partial = set if the answer is cut short by the time budget.
+
+Description:
+	Run count_from() or best_from() on done, whichever is being searched for, leaving the
+  answer in its memo table.
+********************************************/
+void sequence_search::solve(uint64_t done, bool& partial)
+{
+  vector<int> avail;
+  available_after(done, avail);
+  int left = n - __builtin_popcountll(done);
+  if(k == 0)
+    count_from(done, left, avail, partial);
+  else
+    best_from(done, left, avail, partial);
+}
+
+/********************************************
+Procedure Name: search()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - pool = the threads to search on, NULL or one thread to search on this one.
+  - partial = set if the search is cut short by the time budget.
+
+Description:
+	Fill in the memo table from the top sets down with work stealing, as described for
+  the class, then solve the empty set. On one thread that is just the last step.
+********************************************/
+void sequence_search::search(thread_pool* pool, bool& partial)
+{
+  late = false;
+  deadline = chrono::steady_clock::now() + chrono::microseconds((long long)(budget * 1e6));
+
+  if(pool != NULL && pool->size() > 1)
+  {
+    int threads = pool->size();
+    vector<deque<uint64_t> > tasks(threads);
+    vector<mutex> locks(threads);
+    //Tasks handed out and not finished yet, a task's children are counted before it is.
+    atomic<int> pending(1);
+    atomic<bool> cut(false);
+    tasks[0].push_back(0);
+    spawned.insert(0, 1);
+
+    pool->parallel_for(threads, [&](int t)
+    {
+      vector<int> avail;
+      int run[64];
+      while(pending.load() > 0)
+      {
+        //Take the newest task of this thread or steal the oldest of another.
+        uint64_t done = 0;
+        bool got = false;
+        for(int v = 0; v < threads && !got; v++)
+        {
+          int from = (t + v) % threads;
+          lock_guard<mutex> lock(locks[from]);
+          if(!tasks[from].empty())
+          {
+            got = true;
+            if(v == 0)
+            {
+              done = tasks[from].back();
+              tasks[from].pop_back();
+            }
+            else
+            {
+              done = tasks[from].front();
+              tasks[from].pop_front();
+            }
+          }
+        }
+        if(!got)
+        {
+          this_thread::yield();
+          continue;
+        }
+
+        //Split a set near the top into its children, solve one deep enough.
+        bool task_cut = false;
+        if(__builtin_popcountll(done) < search_spawn_depth && __builtin_popcountll(done) < n)
+        {
+          available_after(done, avail);
+          int r = runnable(done, avail, run);
+          for(int i = 0; i < r; i++)
+          {
+            uint64_t child = done | 1ULL << run[i];
+            if(spawned.insert(child, 1))
+            {
+              pending++;
+              lock_guard<mutex> lock(locks[t]);
+              tasks[t].push_back(child);
+            }
+          }
+        }
+        else
+        {
+          solve(done, task_cut);
+        }
+        if(task_cut)
+          cut = true;
+        pending--;
+      }
+    });
+    partial |= cut.load();
+    spawned.clear();
+  }
+
+  solve(0, partial);
+}
+
+/********************************************
+Procedure Name: count()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - pool = the threads to search on, NULL to search on this one.
+
+Description:
+	The number of safe sequences of the state, 0 if it is unsafe. If the time budget runs
+  out the count is a lower bound and complete() is false.
+********************************************/
+seq_count sequence_search::count(thread_pool* pool)
+{
+  late = false;
+  if(!safe_state)
+    return 0;
+  k = 0;
+  counts.clear();
+  bool partial = false;
+  search(pool, partial);
+
+  vector<int> avail = available;
+  return count_from(0, n, avail, partial);
+}
+
+/********************************************
+Procedure Name: best()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - want = the number of sequences wanted.
+  - by = the cost they are ranked by, cost_peak or cost_wait.
+
+Description:
+	The want safe sequences of least cost, cheapest first, fewer if there aren't that
+  many and none if the state is unsafe. Every one is rebuilt by following its links
+  through the memo table.
+********************************************/
+vector<ranked_sequence> sequence_search::best(int want, int by)
+{
+  late = false;
+  vector<ranked_sequence> found;
+  if(!safe_state || want < 1)
+    return found;
+  k = want;
+  cost = by;
+  ranks.clear();
+  bool partial = false;
+  search(NULL, partial);
+
+  vector<int> avail = available;
+  link_list top = best_from(0, n, avail, partial);
+  for(size_t i = 0; i < top->size(); i++)
+  {
+    ranked_sequence seq;
+    seq.cost = (*top)[i].cost;
+    uint64_t done = 0;
+    link l = (*top)[i];
+    while(l.p != -1)
+    {
+      seq.order.push_back(l.p);
+      done |= 1ULL << l.p;
+      if((int)seq.order.size() == n)
+        break;
+      ranked next;
+      ranks.find(done, next);
+      l = (*next.best)[l.rank];
+    }
+    found.push_back(seq);
+  }
+  return found;
+}
+
+#endif /* sequences_h */
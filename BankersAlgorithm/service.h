@@ -0,0 +1,665 @@
+/********************************************
+File Name: 			service.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Class:
+	 admission_service - Holds a state in memory and answers a stream of request, release,
+	                     new process and exit events, each with one safety check at most.
+
+Protocol: one event per line, its words separated by any whitespace, process numbers start at 1
+like in the printed routes.
+
+	 request p r1 ... rm   - process p asks for r1 ... rm more units. Answered GRANT if the
+	                         state stays safe, DENY if it doesn't or if not enough is free.
+	 release p [r1 ... rm] - process p gives back r1 ... rm units, or everything it holds.
+	 new c1 ... cm         - a new process with claim c1 ... cm. Answered GRANT p with the
+	                         number of the new process, or DENY if it claims more than exists.
+	 exit p                - process p finishes and gives back everything it holds.
+	 info                  - answered INFO slots m, process numbers run from 1 to slots.
+	 stats                 - answered STATS granted denied errors hits misses, the last two
+	                         counting safety checks answered from the cache or not.
+	 sequence              - answered SEQUENCE p1 ... pk with the safe sequence of the last
+	                         request granted, as found by its check or stored in the cache.
+	 Anything that can't be carried out is answered ERROR with the reason, among them any
+	 event with a negative number of units.
+
+Procedures:
+
+int request(int p, const int* req), bool release(int p, const int* rel),
+int add_process(const int* claim), bool remove_process(int p)
+    - Members of admission_service that carry out one event on the state.
+
+void handle(const char* line, size_t len, string& out)
+    - Member of admission_service that parses one event line and appends the answer to out.
+
+void serve_stream(admission_service& service, istream& in, ostream& out)
+    - Answer events read line by line from in.
+
+bool serve_socket(admission_service& service, const char* path)
+    - Listen on a Unix domain socket and answer events from any number of clients until
+      SIGINT or SIGTERM.
+********************************************/
+
+#ifndef service_h
+#define service_h
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <string.h>
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "header.h"
+#include "parser.h"
+#include "cache.h"
+
+using namespace std;
+
+/* Macro denoting the most clients served at the same time */
+#define max_clients 64
+
+/* Macro denoting the most a client may send without ending a line before it is dropped, and
+   the most answers kept for a client that isn't reading them before it is no longer read from */
+#define max_pending (1 << 16)
+
+/* Macro denoting the memory the cache of safety checks may take unless told otherwise */
+#define default_cache_bytes (64 << 20)
+
+/* Set by SIGINT or SIGTERM to stop serve_socket() */
+volatile sig_atomic_t stop_serving = 0;
+
+void stop_serving_handler(int)
+{
+  stop_serving = 1;
+}
+
+/********************************************
+Class Name: 		    admission_service
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Holds a state in memory and carries out events on it. The matrices are updated
+        in place, a request is applied, checked with the adaptive checker and rolled
+        back if it leaves the state unsafe. Releases, new processes and exits can't make
+        a safe state unsafe so they are never checked. The slots of processes that exit
+        are reused by new processes.
+
+        A fingerprint of the state is kept up to date with every row that changes, and
+        the answer of every check is cached under it (see cache.h), so a state that
+        comes round again is answered without a check, along with the safe sequence the
+        check found for it.
+********************************************/
+class admission_service
+{
+private:
+  //the state being served
+  state info;
+  //number of resources
+  int m;
+  //1 for every slot holding a live process
+  vector<char> live;
+  //the live slots, in the order the safety check considers them
+  vector<int> active;
+  //position of every live slot in active
+  vector<int> where;
+  //slots free for new processes
+  vector<int> free_slots;
+  //checker kept between events so its buffers are reused
+  adaptive_checker checker;
+  //the fingerprint of the live rows, the answers cached under it, the sequence of the last
+  //check and the safe sequence of the last request granted
+  state_fingerprint print;
+  safe_cache cache;
+  vector<int> sequence;
+  vector<int> granted_sequence;
+  //scratch space for the numbers on an event line
+  vector<int> numbers;
+  //number of requests and new processes granted and denied, and of events in error
+  long granted, denied, errors;
+
+  bool valid(int p) const { return p >= 0 && p < (int)live.size() && live[p]; }
+
+  //Whether any of the m units of an event is negative.
+  bool negative(const int* units) const
+  {
+    for(int j = 0; j < m; j++)
+    {
+      if(units[j] < 0)
+        return true;
+    }
+    return false;
+  }
+
+  bool is_safe()
+  {
+    //A state seen before is answered from the cache.
+    uint64_t key = print.value();
+    if(cache.enabled())
+    {
+      const cache_entry* e = cache.find(key);
+      if(e != NULL)
+      {
+        sequence = e->sequence;
+        return e->safe;
+      }
+    }
+
+    count_metric(metric_safe_calls, 1);
+    time_phase(phase_check);
+    sequence.clear();
+    checker.start(info.need, info.allocation, info.available, active, m);
+    int p;
+    while((p = checker.next()) != -1)
+    {
+      sequence.push_back(p);
+    }
+    bool safe = checker.remaining() == 0;
+    if(cache.enabled())
+      cache.insert(key, safe, sequence);
+    return safe;
+  }
+
+  //Move resources from the available vector to process p, sign = -1 gives them back.
+  void move(int p, const int* amount, int sign)
+  {
+    int* allocation = info.allocation.mutable_row(p);
+    int* need = info.need.mutable_row(p);
+    for(int j = 0; j < m; j++)
+    {
+      allocation[j] += sign * amount[j];
+      need[j] -= sign * amount[j];
+      info.available[j] -= sign * amount[j];
+    }
+    print.update_row(p, info, m);
+    print.update_available(info.available, m);
+  }
+
+public:
+  admission_service(const state& s, int n, int res, size_t cache_bytes = default_cache_bytes)
+    : info(s), m(res), live(n, 1), active(n), where(n), cache(cache_bytes), granted(0), denied(0), errors(0)
+  {
+    for(int i = 0; i < n; i++)
+    {
+      active[i] = i;
+      where[i] = i;
+    }
+    print.reset(info, n, m);
+  }
+
+  int slots() const { return live.size(); }
+  int resources() const { return m; }
+  const state& current() const { return info; }
+  const safe_cache& checks() const { return cache; }
+  safe_cache& checks() { return cache; }
+  const vector<int>& last_sequence() const { return granted_sequence; }
+
+  //Carry out a request by process p, returns event_grant, event_deny or event_error.
+  int request(int p, const int* req);
+
+  //Give back rel, or everything p holds if rel is NULL.
+  bool release(int p, const int* rel);
+
+  //Add a process with the given claim, returns its number, -1 or -2.
+  int add_process(const int* claim);
+
+  //Give back everything p holds and free its slot.
+  bool remove_process(int p);
+
+  //Parse one event line, carry it out and append the answer to out.
+  void handle(const char* line, size_t len, string& out);
+};
+
+/********************************************
+Procedure Name: request()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process asking, counted from 0.
+  - req = the m units it asks for.
+Description:
+	Grant the request if enough is free and the state stays safe. The request is
+  kept in the request matrix whatever the answer, unless it is in error because p is no
+  process or some of the units asked for are negative.
+********************************************/
+int admission_service::request(int p, const int* req)
+{
+  if(!valid(p) || negative(req))
+  {
+    count_metric(metric_errors, 1);
+    return event_error;
+  }
+  memcpy(info.request.mutable_row(p), req, m * sizeof(int));
+  if(reqGTclaim(info, p, m))
+  {
+    count_metric(metric_errors, 1);
+    return event_error;
+  }
+  if(reqGTavail(info, p, m))
+  {
+    denied++;
+    count_metric(metric_suspended, 1);
+    return event_deny;
+  }
+
+  move(p, req, 1);
+  if(is_safe())
+  {
+    granted_sequence.swap(sequence);
+    granted++;
+    count_metric(metric_grants, 1);
+    return event_grant;
+  }
+  move(p, req, -1);
+  denied++;
+  count_metric(metric_suspended, 1);
+  return event_deny;
+}
+
+/********************************************
+Procedure Name: release()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process giving resources back, counted from 0.
+  - rel = the m units given back, NULL for everything it holds.
+Description:
+	Give resources back. Returns false if p holds less than rel or some of rel is
+  negative, which would hand p units without a safety check.
+********************************************/
+bool admission_service::release(int p, const int* rel)
+{
+  if(!valid(p) || (rel != NULL && negative(rel)))
+    return false;
+  if(rel == NULL)
+  {
+    numbers.assign(info.allocation.row(p).begin(), info.allocation.row(p).end());
+    rel = numbers.data();
+  }
+  else if(!row_le(rel, info.allocation.row(p).data, m))
+  {
+    return false;
+  }
+  move(p, rel, -1);
+  return true;
+}
+
+/********************************************
+Procedure Name: add_process()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - claim = the m units the new process claims.
+Description:
+	Add a process holding nothing. Returns its number, -1 if it claims more than
+  there is of some resource and could never finish, or -2 if some of its claim is
+  negative.
+********************************************/
+int admission_service::add_process(const int* claim)
+{
+  if(negative(claim))
+    return -2;
+  if(!row_le(claim, info.resource.data(), m))
+  {
+    denied++;
+    return -1;
+  }
+
+  int p;
+  if(!free_slots.empty())
+  {
+    p = free_slots.back();
+    free_slots.pop_back();
+  }
+  else
+  {
+    p = live.size();
+    live.push_back(0);
+    where.push_back(0);
+    info.claim.resize_rows(p + 1);
+    info.allocation.resize_rows(p + 1);
+    info.request.resize_rows(p + 1);
+    info.need.resize_rows(p + 1);
+  }
+
+  memcpy(info.claim.mutable_row(p), claim, m * sizeof(int));
+  memcpy(info.need.mutable_row(p), claim, m * sizeof(int));
+  memset(info.allocation.mutable_row(p), 0, m * sizeof(int));
+  memset(info.request.mutable_row(p), 0, m * sizeof(int));
+  live[p] = 1;
+  print.update_row(p, info, m);
+  where[p] = active.size();
+  active.push_back(p);
+  granted++;
+  return p;
+}
+
+/********************************************
+Procedure Name: remove_process()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - p = the process that finished, counted from 0.
+Description:
+	Give back everything p holds and free its slot.
+********************************************/
+bool admission_service::remove_process(int p)
+{
+  if(!release(p, NULL))
+    return false;
+  memset(info.claim.mutable_row(p), 0, m * sizeof(int));
+  memset(info.need.mutable_row(p), 0, m * sizeof(int));
+  live[p] = 0;
+  print.drop_row(p);
+  //Swap the last live slot into p's place.
+  int last = active.back();
+  active[where[p]] = last;
+  where[last] = where[p];
+  active.pop_back();
+  free_slots.push_back(p);
+  return true;
+}
+
+/********************************************
+Procedure Name: handle()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - line & len = one event line, without the newline.
+  - out = the string the answer and a newline are appended to.
+Description:
+	Parse one event line, carry it out and append the answer to out. The command and the
+  numbers may be separated by any whitespace, as in the input files.
+********************************************/
+void admission_service::handle(const char* line, size_t len, string& out)
+{
+  const char* end = line + len;
+  while(line < end && is_blank(*line))
+    line++;
+  const char* word = line;
+  while(line < end && !is_blank(*line))
+    line++;
+  string cmd(word, line - word);
+
+  //Read all the numbers after the command, anything else left over is a bad number.
+  numbers.clear();
+  int_scanner in = { line, end };
+  int v;
+  while(in.next(v))
+  {
+    numbers.push_back(v);
+  }
+  while(in.p < end && is_blank(*in.p))
+    in.p++;
+  if(in.p != end)
+  {
+    errors++;
+    out += "ERROR bad number\n";
+    return;
+  }
+
+  int count = numbers.size();
+  int p = count > 0 ? numbers[0] - 1 : -1;
+  if(cmd == "request" && count == m + 1)
+  {
+    int answer = request(p, numbers.data() + 1);
+    if(answer == event_grant)
+      out += "GRANT\n";
+    else if(answer == event_deny)
+      out += "DENY\n";
+    else
+    {
+      errors++;
+      out += "ERROR request over claim, negative or no such process\n";
+    }
+  }
+  else if(cmd == "release" && (count == 1 || count == m + 1))
+  {
+    if(release(p, count == 1 ? NULL : numbers.data() + 1))
+      out += "OK\n";
+    else
+    {
+      errors++;
+      out += "ERROR release over allocation, negative or no such process\n";
+    }
+  }
+  else if(cmd == "new" && count == m)
+  {
+    int q = add_process(numbers.data());
+    if(q == -2)
+    {
+      errors++;
+      out += "ERROR negative claim\n";
+    }
+    else if(q < 0)
+      out += "DENY\n";
+    else
+    {
+      char buffer[12];
+      out += "GRANT ";
+      out.append(buffer, to_chars(buffer, buffer + sizeof(buffer), q + 1).ptr - buffer);
+      out += "\n";
+    }
+  }
+  else if(cmd == "exit" && count == 1)
+  {
+    if(remove_process(p))
+      out += "OK\n";
+    else
+    {
+      errors++;
+      out += "ERROR no such process\n";
+    }
+  }
+  else if(cmd == "info" && count == 0)
+  {
+    out += "INFO " + to_string(slots()) + " " + to_string(m) + "\n";
+  }
+  else if(cmd == "sequence" && count == 0)
+  {
+    char buffer[12];
+    out += "SEQUENCE";
+    for(size_t k = 0; k < granted_sequence.size(); k++)
+    {
+      out += " ";
+      out.append(buffer, to_chars(buffer, buffer + sizeof(buffer), granted_sequence[k] + 1).ptr - buffer);
+    }
+    out += "\n";
+  }
+  else if(cmd == "stats" && count == 0)
+  {
+    out += "STATS " + to_string(granted) + " " + to_string(denied) + " " + to_string(errors) + " "
+         + to_string(cache.hits) + " " + to_string(cache.misses) + "\n";
+  }
+  else
+  {
+    errors++;
+    out += "ERROR unknown event\n";
+  }
+}
+
+/********************************************
+Procedure Name: serve_stream()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - service = the service carrying out the events.
+  - in & out = where the events are read from and the answers written to.
+
+Description:
+	Answer events read line by line from in until it is closed. Every answer is flushed
+  straight away since whoever sends the events is waiting on it.
+********************************************/
+void serve_stream(admission_service& service, istream& in, ostream& out)
+{
+  string line;
+  string answer;
+  while(getline(in, line))
+  {
+    answer.clear();
+    service.handle(line.data(), line.size(), answer);
+    out << answer << flush;
+  }
+}
+
+/********************************************
+Procedure Name: serve_socket()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - service = the service carrying out the events.
+  - path = where the socket is to be created.
+
+Description:
+	Listen on a Unix domain socket at path and answer events from every client that
+  connects, one line at a time, until the program gets SIGINT or SIGTERM, then close
+  every connection and remove the socket so the caller can save what it needs to.
+  Clients are served from one thread with ppoll(), so the events of all clients are
+  carried out one after the other. Returns false if the socket can't be set up.
+
+  Client sockets are non-blocking. The answers to a client are queued and sent as far as
+  its socket takes them, and the rest when ppoll() says it can take more, so a client that
+  stops reading holds up nobody else. While it has max_pending bytes of answers waiting it
+  isn't read from either, which stops its queue from growing. Answers are sent with
+  MSG_NOSIGNAL, so a client that goes away before its answer is written is dropped rather
+  than killing the service with SIGPIPE. While max_clients are connected the listener is
+  left out of the poll and new clients wait in the backlog, and a client sending more than
+  max_pending bytes without a newline is dropped.
+********************************************/
+bool serve_socket(admission_service& service, const char* path)
+{
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  if(listener < 0)
+    return false;
+
+  sockaddr_un addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strncpy(addr.sun_path, path, sizeof(addr.sun_path) - 1);
+  unlink(path);
+  if(bind(listener, (sockaddr*)&addr, sizeof(addr)) < 0 || listen(listener, max_clients) < 0)
+  {
+    close(listener);
+    return false;
+  }
+
+  //The listener is always the first entry, then one per client with its unfinished line
+  //and the answers not yet sent to it.
+  vector<pollfd> fds(1);
+  vector<string> pending(1);
+  vector<string> outgoing(1);
+  fds[0].fd = listener;
+  fds[0].events = POLLIN;
+  char buf[1 << 16];
+
+  //Stop on SIGINT or SIGTERM. They are blocked except inside ppoll(), so one can't
+  //slip in between the test of stop_serving and the wait.
+  struct sigaction stop;
+  memset(&stop, 0, sizeof(stop));
+  stop.sa_handler = stop_serving_handler;
+  sigemptyset(&stop.sa_mask);
+  sigaction(SIGINT, &stop, NULL);
+  sigaction(SIGTERM, &stop, NULL);
+  sigset_t blocked, waiting;
+  sigemptyset(&blocked);
+  sigaddset(&blocked, SIGINT);
+  sigaddset(&blocked, SIGTERM);
+  sigprocmask(SIG_BLOCK, &blocked, &waiting);
+
+  while(!stop_serving)
+  {
+    //Only listen for new clients while there is room for them.
+    fds[0].events = fds.size() <= max_clients ? POLLIN : 0;
+    if(ppoll(fds.data(), fds.size(), NULL, &waiting) < 0)
+      continue;
+
+    if(fds[0].revents & POLLIN)
+    {
+      int client = accept(listener, NULL, NULL);
+      if(client >= 0)
+      {
+        fcntl(client, F_SETFL, fcntl(client, F_GETFL) | O_NONBLOCK);
+        pollfd pfd = {client, POLLIN, 0};
+        fds.push_back(pfd);
+        pending.push_back("");
+        outgoing.push_back("");
+      }
+    }
+
+    for(size_t k = 1; k < fds.size(); k++)
+    {
+      if(fds[k].revents == 0)
+        continue;
+      bool drop = (fds[k].revents & (POLLERR | POLLNVAL)) != 0;
+
+      if(!drop && (fds[k].revents & (POLLIN | POLLHUP)))
+      {
+        ssize_t got = read(fds[k].fd, buf, sizeof(buf));
+        if(got > 0)
+        {
+          //Answer every complete line, keep the rest for the next read.
+          pending[k].append(buf, got);
+          size_t start = 0, nl;
+          while((nl = pending[k].find('\n', start)) != string::npos)
+          {
+            service.handle(pending[k].data() + start, nl - start, outgoing[k]);
+            start = nl + 1;
+          }
+          pending[k].erase(0, start);
+          //A client that never ends its line is dropped before it fills the memory.
+          drop = pending[k].size() > max_pending;
+        }
+        else
+        {
+          //The client went away, drop it.
+          drop = got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR);
+        }
+      }
+
+      //Send what the socket takes now, the rest waits for POLLOUT.
+      size_t sent = 0;
+      while(!drop && sent < outgoing[k].size())
+      {
+        ssize_t w = send(fds[k].fd, outgoing[k].data() + sent, outgoing[k].size() - sent, MSG_NOSIGNAL);
+        if(w > 0)
+          sent += w;
+        else if(errno == EAGAIN || errno == EWOULDBLOCK)
+          break;
+        else if(errno != EINTR)
+          drop = true;
+      }
+      outgoing[k].erase(0, sent);
+
+      if(drop)
+      {
+        close(fds[k].fd);
+        fds.erase(fds.begin() + k);
+        pending.erase(pending.begin() + k);
+        outgoing.erase(outgoing.begin() + k);
+        k--;
+        continue;
+      }
+      fds[k].events = (outgoing[k].size() < max_pending ? POLLIN : 0) | (outgoing[k].empty() ? 0 : POLLOUT);
+    }
+  }
+
+  for(size_t k = 0; k < fds.size(); k++)
+  {
+    close(fds[k].fd);
+  }
+  unlink(path);
+  sigprocmask(SIG_SETMASK, &waiting, NULL);
+  return true;
+}
+
+#endif /* service_h */
@@ -0,0 +1,142 @@
+/********************************************
+File Name: 			threadpool.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Class:
+	 thread_pool - A fixed set of worker threads that run the iterations of a loop in
+	               parallel.
+
+Procedures: Members of the thread_pool class.
+
+thread_pool(int threads)
+    - Start threads - 1 workers, the thread calling parallel_for() is the last one.
+
+void parallel_for(int count, const function<void(int)>& body)
+    - Run body(0) ... body(count - 1) on all the threads and wait for them to finish.
+      Iterations are handed out in increasing order.
+
+int size() const
+    - The number of threads that run iterations, the caller included.
+********************************************/
+
+#ifndef threadpool_h
+#define threadpool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/********************************************
+Class Name: 		    thread_pool
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        A fixed set of worker threads that sleep until parallel_for() hands them a loop.
+        Every thread takes the next iteration from a shared atomic counter, so the
+        iterations are started in increasing order and a slow one doesn't hold up the
+        rest.
+********************************************/
+class thread_pool
+{
+private:
+  //the worker threads
+  vector<thread> workers;
+  //guards everything below except next
+  mutex mtx;
+  //wakes the workers when there is a loop to run, and the caller when it is done
+  condition_variable start_cv, done_cv;
+  //the loop being run and its number of iterations
+  const function<void(int)>* body;
+  int count;
+  //the next iteration to be handed out
+  atomic<int> next;
+  //bumped for every loop so the workers know there is a new one
+  long generation;
+  //number of workers still on the current loop
+  int running;
+  //set when the pool is being destroyed
+  bool stop;
+
+  //Take iterations of the current loop until there are none left.
+  void drain()
+  {
+    int i;
+    while((i = next.fetch_add(1)) < count)
+    {
+      (*body)(i);
+    }
+  }
+
+  void work()
+  {
+    long seen = 0;
+    while(true)
+    {
+      {
+        unique_lock<mutex> lock(mtx);
+        start_cv.wait(lock, [&] { return stop || generation != seen; });
+        if(stop)
+          return;
+        seen = generation;
+      }
+      drain();
+      {
+        unique_lock<mutex> lock(mtx);
+        if(--running == 0)
+          done_cv.notify_one();
+      }
+    }
+  }
+
+public:
+  thread_pool(int threads) : body(NULL), count(0), next(0), generation(0), running(0), stop(false)
+  {
+    for(int t = 1; t < threads; t++)
+    {
+      workers.push_back(thread(&thread_pool::work, this));
+    }
+  }
+
+  ~thread_pool()
+  {
+    {
+      unique_lock<mutex> lock(mtx);
+      stop = true;
+    }
+    start_cv.notify_all();
+    for(size_t t = 0; t < workers.size(); t++)
+    {
+      workers[t].join();
+    }
+  }
+
+  int size() const { return workers.size() + 1; }
+
+  void parallel_for(int n, const function<void(int)>& fn)
+  {
+    {
+      unique_lock<mutex> lock(mtx);
+      body = &fn;
+      count = n;
+      next = 0;
+      running = workers.size();
+      generation++;
+    }
+    start_cv.notify_all();
+    drain();
+
+    unique_lock<mutex> lock(mtx);
+    done_cv.wait(lock, [&] { return running == 0; });
+  }
+};
+
+#endif /* threadpool_h */
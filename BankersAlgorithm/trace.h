@@ -0,0 +1,392 @@
+/********************************************
+File Name: 			trace.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Enum:
+	 trace_level - How much of a safety check is printed: nothing, the route reached by
+	               every check, or the route and matrices after every step.
+
+Class:
+	 tracer - Collects the output of the safety checks. Text is built up in a buffer and
+	          written out in large blocks. Optionally every check is also written to a
+	          compact binary trace which can be replayed later to print the matrices.
+
+Binary trace format (all values native endian int32):
+	 header - 'B' 'K' 'T' 'R', version, n, m, then the claim, allocation and request
+	          matrices of the initial state, n * m values each, row by row.
+	 check  - trace_check, the process in question, the available vector and the
+	          allocation row of the process in question at the start of the check.
+	 step   - trace_step, the process that ran to completion, the processes left.
+	 end    - trace_end, 1 if the check found a safe sequence, 0 otherwise.
+
+Procedures: Members of the tracer class.
+
+void open_binary(const char* path, const matrix& claim, const matrix& allocation, const matrix& request, int n, int m)
+    - Start writing a binary trace of every check to path.
+
+void begin_check(...), step(...), end_check(...)
+    - Called by safe() at the start of a check, after every process that runs to completion,
+      and at the end of a check.
+
+void text(const char* str)
+    - Add str to the text output whatever the trace level is.
+
+void flush()
+    - Write out the buffered text.
+
+void route_step(string& route, int p, int remaining)
+    - Add process p to a route, followed by an arrow if any processes remain.
+
+bool replay_trace(const char* path, tracer& out)
+    - Read back a binary trace and print it through out as a full trace.
+********************************************/
+
+#ifndef trace_h
+#define trace_h
+
+#include <stdio.h>
+#include <string.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <charconv>
+
+#include "matrix.h"
+
+using namespace std;
+
+/* Macro denoting the amount of buffered text that triggers a write */
+#define trace_buffer_size (1 << 16)
+
+/* Record tags in the binary trace */
+#define trace_check 1
+#define trace_step 2
+#define trace_end 3
+
+enum trace_level
+{
+  trace_off,
+  trace_route,
+  trace_full
+};
+
+/********************************************
+Class Name: 		    tracer
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+        Collects the output of the safety checks. At trace_full the route, the claim,
+        allocation and request matrices and the available vector are printed after
+        every step, the same as safe() always used to. At trace_route only the route
+        reached by each check is printed and at trace_off nothing is. Text goes to a
+        buffer which is written out whenever it grows past trace_buffer_size.
+********************************************/
+class tracer
+{
+private:
+  //where the text output goes
+  ostream* os;
+  //the text not written out yet
+  string buf;
+  //the binary trace, NULL when not tracing to a file
+  FILE* bin;
+
+  void put_int(int v)
+  {
+    char digits[12];
+    char* end = to_chars(digits, digits + sizeof(digits), v).ptr;
+    buf.append(digits, end - digits);
+  }
+
+  void put_ints(const int* v, int m)
+  {
+    fwrite(v, sizeof(int), m, bin);
+  }
+
+  void put_matrix(const char* str, const matrix& mat, int n, int m)
+  {
+    buf += "\n";
+    buf += str;
+    buf += "\n";
+    for(int i = 0; i < n; i++)
+    {
+      row_view r = mat.row(i);
+      for(int j = 0; j < m; j++)
+      {
+        put_int(r[j]);
+        buf += ' ';
+      }
+      buf += '\n';
+    }
+  }
+
+  void maybe_flush()
+  {
+    if(buf.size() >= trace_buffer_size)
+      flush();
+  }
+
+public:
+  //how much of each check is printed
+  trace_level level;
+
+  tracer(ostream& out = cout, trace_level lvl = trace_full) : os(&out), bin(NULL), level(lvl) {}
+
+  ~tracer()
+  {
+    flush();
+    if(bin != NULL)
+      fclose(bin);
+  }
+
+  bool open_binary(const char* path, const matrix& claim, const matrix& allocation,
+                   const matrix& request, int n, int m)
+  {
+    bin = fopen(path, "wb");
+    if(bin == NULL)
+      return false;
+    setvbuf(bin, NULL, _IOFBF, trace_buffer_size);
+    int header[4] = {0, 1, n, m};
+    memcpy(header, "BKTR", 4);
+    put_ints(header, 4);
+    const matrix* mats[3] = {&claim, &allocation, &request};
+    for(int k = 0; k < 3; k++)
+    {
+      for(int i = 0; i < n; i++)
+      {
+        put_ints(mats[k]->row(i).data, m);
+      }
+    }
+    return true;
+  }
+
+  //True if safe() has to keep its state copy up to date for printing.
+  bool wants_matrices() const { return level == trace_full; }
+
+  void begin_check(int cur_proc, const vector<int>& available, const matrix& allocation, int m)
+  {
+    if(bin != NULL)
+    {
+      int rec[2] = {trace_check, cur_proc};
+      put_ints(rec, 2);
+      put_ints(available.data(), m);
+      put_ints(allocation.row(cur_proc).data, m);
+    }
+  }
+
+  void step(int p, int remaining, const string& route, const matrix& claim, const matrix& allocation,
+            const matrix& request, const vector<int>& available, int n, int m)
+  {
+    if(bin != NULL)
+    {
+      int rec[3] = {trace_step, p, remaining};
+      put_ints(rec, 3);
+    }
+    if(level != trace_full)
+      return;
+
+    //Print out the route up until now and the updated claim, allocation and request matrices.
+    buf += route;
+    put_matrix("Claim Matrix", claim, n, m);
+    put_matrix("Allocation Matrix", allocation, n, m);
+    put_matrix("Request Matrix", request, n, m);
+
+    //Print out the vector containing the resoruces currently available
+    buf += "\nAvailable Vector\n";
+    for(int i = 0; i < m; i++)
+    {
+      put_int(available[i]);
+      buf += ' ';
+    }
+    buf += "\n\n**************************************\n\n";
+    maybe_flush();
+  }
+
+  void end_check(bool safe, const string& route)
+  {
+    if(bin != NULL)
+    {
+      int rec[2] = {trace_end, safe};
+      put_ints(rec, 2);
+    }
+    if(level == trace_route)
+    {
+      buf += route;
+      buf += '\n';
+      maybe_flush();
+    }
+  }
+
+  void text(const char* str)
+  {
+    buf += str;
+    maybe_flush();
+  }
+
+  void text(const string& str)
+  {
+    buf += str;
+    maybe_flush();
+  }
+
+  void flush()
+  {
+    if(!buf.empty())
+    {
+      os->write(buf.data(), buf.size());
+      os->flush();
+      buf.clear();
+    }
+  }
+};
+
+/* The tracer safe() reports to unless it is given another one */
+tracer default_tracer;
+
+/********************************************
+Procedure Name: route_step()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - route = the route the process is added to.
+  - p = the process that ran to completion, counted from 0.
+  - remaining = the number of processes still to run.
+
+Description:
+	Add "Pp" to the route, with an arrow after it if any processes remain. Every safety
+  check and the trace replay build their routes with it, so they print the same. The
+  number is written with to_chars rather than snprintf.
+********************************************/
+inline void route_step(string& route, int p, int remaining)
+{
+  char buffer[12];
+  route += 'P';
+  route.append(buffer, to_chars(buffer, buffer + sizeof(buffer), p+1).ptr);
+  if(remaining > 0)
+    route += " -> ";
+}
+
+/********************************************
+Procedure Name: replay_trace()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the binary trace to be read.
+  - out = the tracer the checks are replayed through, normally at trace_full.
+
+Description:
+	Read back a binary trace written by open_binary() and replay every check in it through
+  out, rebuilding the matrices and the available vector step by step. Every check is taken
+  to start with an empty route, which is how main() runs them. Returns false if the file
+  can't be read or isn't a trace, and stops with false at the first record that doesn't fit
+  the header: a process number out of range, a step outside a check, or a file too short for
+  the n and m it claims, so a truncated or corrupt trace is never indexed out of bounds.
+********************************************/
+bool replay_trace(const char* path, tracer& out)
+{
+  FILE* in = fopen(path, "rb");
+  if(in == NULL)
+    return false;
+
+  int header[4];
+  if(fread(header, sizeof(int), 4, in) != 4 || memcmp(header, "BKTR", 4) != 0 || header[1] != 1)
+  {
+    fclose(in);
+    return false;
+  }
+  int n = header[2];
+  int m = header[3];
+
+  //The initial state has to be in the file before anything is made for it.
+  long size = 0;
+  if(fseek(in, 0, SEEK_END) == 0)
+    size = ftell(in);
+  if(n <= 0 || m <= 0 || fseek(in, 4 * sizeof(int), SEEK_SET) != 0
+     || (long long)n * m > (size - 4 * (long long)sizeof(int)) / (3 * (long long)sizeof(int)))
+  {
+    fclose(in);
+    return false;
+  }
+
+  //Read the initial state.
+  matrix base[3] = {matrix(n, m), matrix(n, m), matrix(n, m)};
+  for(int k = 0; k < 3; k++)
+  {
+    for(int i = 0; i < n; i++)
+    {
+      if(fread(base[k].mutable_row(i), sizeof(int), m, in) != (size_t)m)
+      {
+        fclose(in);
+        return false;
+      }
+    }
+  }
+
+  matrix claim, allocation, request;
+  vector<int> available(m);
+  string route;
+  int tag;
+  bool ok = true;
+  //Whether a check has been started, steps and ends only make sense inside one.
+  bool in_check = false;
+  while(ok && fread(&tag, sizeof(int), 1, in) == 1)
+  {
+    if(tag == trace_check)
+    {
+      //Every check starts from the initial state with the process in question's row updated.
+      int cur_proc;
+      claim = base[0];
+      allocation = base[1];
+      request = base[2];
+      route = "";
+      ok = fread(&cur_proc, sizeof(int), 1, in) == 1
+        && cur_proc >= 0 && cur_proc < n
+        && fread(available.data(), sizeof(int), m, in) == (size_t)m
+        && fread(allocation.mutable_row(cur_proc), sizeof(int), m, in) == (size_t)m;
+      in_check = ok;
+    }
+    else if(tag == trace_step)
+    {
+      int rec[2];
+      ok = in_check && fread(rec, sizeof(int), 2, in) == 2
+        && rec[0] >= 0 && rec[0] < n && rec[1] >= 0 && rec[1] < n;
+      if(!ok)
+        break;
+      int p = rec[0];
+      int* c = claim.mutable_row(p);
+      int* a = allocation.mutable_row(p);
+      int* r = request.mutable_row(p);
+      for(int i = 0; i < m; i++)
+      {
+        available[i] += a[i];
+        a[i] = 0;
+        c[i] = 0;
+        r[i] = 0;
+      }
+      route_step(route, p, rec[1]);
+      out.step(p, rec[1], route, claim, allocation, request, available, n, m);
+    }
+    else if(tag == trace_end)
+    {
+      int safe;
+      ok = in_check && fread(&safe, sizeof(int), 1, in) == 1;
+      if(ok)
+        out.end_check(safe, route);
+      in_check = false;
+    }
+    else
+    {
+      ok = false;
+    }
+  }
+
+  fclose(in);
+  out.flush();
+  return ok;
+}
+
+#endif /* trace_h */
@@ -0,0 +1,188 @@
+/********************************************
+File Name: 			workload.h
+Author: 				del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+Struct:
+	 workload - The shape of a generated state: its size, how many of the claims are
+	            nonzero, how much is left over and whether it is meant to be safe.
+
+Procedures:
+
+bool generate_state(struct state& x, const workload& w, mt19937& gen)
+    - Fill x with a random state of the given shape. Returns whether it is safe.
+
+bool write_text(const char* path, const struct state& x, int n, int m)
+    - Write x out in the text format of the input files.
+********************************************/
+
+#ifndef workload_h
+#define workload_h
+
+#include <stdio.h>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include "header.h"
+
+using namespace std;
+
+/********************************************
+Structure Name: 		workload
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+        The shape of a generated state.
+********************************************/
+struct workload
+{
+  //number of processes and resources
+  int n, m;
+  //fraction of the claims that are nonzero
+  double density;
+  //units of every resource left free over the least the safe sequence needs
+  int slack;
+  //whether the state is meant to be safe
+  bool safe;
+  //the largest claim of one process for one resource
+  int max_claim;
+};
+
+/********************************************
+Procedure Name: generate_state()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - x = the state to be filled in.
+  - w = the shape of the state.
+  - gen = the random number generator to draw from.
+
+Description:
+	Fill x with a random state. Every claim is nonzero with probability w.density, and
+  every process holds a random part of its claim and asks for the rest. A random order
+  of the processes is picked and the available vector is set to the least that lets
+  them run to completion in that order, plus w.slack of every resource. The state is
+  then safe, and as tight as the order allows when w.slack is 0.
+
+  For an unsafe state the available vector is then cut down, by 1, 2, 4 ... units of
+  every resource, until the safety check fails. Returns whether the state ended up
+  safe, which for an unsafe workload is only the case if it was safe with nothing
+  available at all.
+********************************************/
+bool generate_state(struct state& x, const workload& w, mt19937& gen)
+{
+  int n = w.n, m = w.m;
+  bernoulli_distribution nonzero(w.density);
+  uniform_int_distribution<int> claims(1, w.max_claim);
+  x.claim = matrix(n, m);
+  x.allocation = matrix(n, m);
+  for(int i = 0; i < n; i++)
+  {
+    int* claim = x.claim.mutable_row(i);
+    int* allocation = x.allocation.mutable_row(i);
+    for(int j = 0; j < m; j++)
+    {
+      claim[j] = nonzero(gen) ? claims(gen) : 0;
+      allocation[j] = uniform_int_distribution<int>(0, claim[j])(gen);
+    }
+  }
+  compute_need(x, n, m);
+  x.request = x.need;
+
+  //Walk a random order, the available vector has to cover each need less what came back before it.
+  vector<int> order(n);
+  for(int i = 0; i < n; i++)
+  {
+    order[i] = i;
+  }
+  shuffle(order.begin(), order.end(), gen);
+  vector<int> returned(m, 0);
+  x.available.assign(m, 0);
+  for(int k = 0; k < n; k++)
+  {
+    row_view need = x.need.row(order[k]);
+    row_view allocation = x.allocation.row(order[k]);
+    for(int j = 0; j < m; j++)
+    {
+      x.available[j] = max(x.available[j], need[j] - returned[j]);
+      returned[j] += allocation[j];
+    }
+  }
+  for(int j = 0; j < m; j++)
+  {
+    x.available[j] += w.slack;
+  }
+
+  //Cut the available vector down until the state is unsafe.
+  vector<int> tight = x.available;
+  bool is_safe = true;
+  for(int cut = 1; !w.safe && is_safe; cut *= 2)
+  {
+    bool any = false;
+    for(int j = 0; j < m; j++)
+    {
+      x.available[j] = max(tight[j] - cut, 0);
+      any = any || x.available[j] > 0;
+    }
+    incremental_checker c;
+    c.start(x.need, x.allocation, x.available, order, m);
+    while(c.next() != -1);
+    is_safe = c.remaining() == 0;
+    if(!any)
+      break;
+  }
+
+  x.resource = x.available;
+  for(int j = 0; j < m; j++)
+  {
+    x.resource[j] += returned[j];
+  }
+  return is_safe;
+}
+
+/********************************************
+Procedure Name: write_text()
+Author: 				del_dilettante
+Date: 					10/17/2026
+Parameters:
+  - path = the file to be written.
+  - x = the state to be written.
+  - n & m = number of processes and resources.
+
+Description:
+	Write x out the way the input files are laid out: the number of resources, the
+  resource vector, the number of processes, then the claim and allocation matrices.
+  Returns false if the file can't be written.
+********************************************/
+bool write_text(const char* path, const struct state& x, int n, int m)
+{
+  FILE* out = fopen(path, "w");
+  if(out == NULL)
+    return false;
+  fprintf(out, "%d\n", m);
+  for(int j = 0; j < m; j++)
+  {
+    fprintf(out, j + 1 < m ? "%d " : "%d\n", x.resource[j]);
+  }
+  fprintf(out, "%d\n", n);
+  const matrix* mats[2] = {&x.claim, &x.allocation};
+  for(int k = 0; k < 2; k++)
+  {
+    for(int i = 0; i < n; i++)
+    {
+      row_view r = mats[k]->row(i);
+      for(int j = 0; j < m; j++)
+      {
+        fprintf(out, j + 1 < m ? "%d " : "%d\n", r[j]);
+      }
+    }
+  }
+  bool ok = !ferror(out);
+  return fclose(out) == 0 && ok;
+}
+
+#endif /* workload_h */
@@ -1,41 +1,61 @@
 /********************************************
 File Name: 			        header.h
 Author: 				        del_dilettante
-Last Modification Date: 11/8/2020
+Last Modification Date: 10/17/2026
 Last Modifier:          del_dilettante
 
 Struct:
 	 simInfo - A structure to hold the total of the turnaround times and the normalise turnaround
              times for a given simulation.
+
 Class:
     simulation - A class object that represents in simulation instance.
 
 Procedures: Members of the simulation class.
 
 simulation (vector<int>&)
-    - The constructor for the simulation class. Takes a vector of ints by reference as an input.
+    - The constructor for the simulation class. Takes the service times of the processes, one
+      process per time.
 
 simInfo& runSimulation()
     - The core logic of the program. Runs the simulation on a set of 1000 processes using the four
       scheduling algos, FCFS, RR, HRRN and FB.
+
+vector<policyInfo> runPolicies(const vector<const policyEntry*>&, const policyConfig&)
+    - Run any number of policies over the processes, one after the other, and return their totals.
+
+vector<multicoreInfo> runMulticore(const vector<const policyEntry*>&, const policyConfig&, const multicoreConfig&)
+    - The same on many processors.
+
+void addTotals(vector<process>&, int)
+    - Add the TaTs and NorTats of the finished processes of one algo to the totals.
+
 ********************************************/
 
 #include "process_rds190000.h"
+#include "policy_rds190000.h"
+#include "multicore_rds190000.h"
+#include <chrono>
+#include <algorithm>
 #ifndef HEADER_RDS190000_H
 #define HEADER_RDS190000_H
 
-/* Macro denoting the size of one simulation */
+/* Macro denoting the size of one simulation, unless main is given another */
 #define sim_size 1000
 
 /*Macro denoting the number of time steps per simulation*/
 #define sim_time 20000
 
-/*Macro denoting the total number of simulations to be run */
+/*Macro denoting the total number of simulations to be run, unless main is given another */
 #define num_sims 1000
 
-/*Macro denoting the number of queues in the feedback algorithm*/
+/*Macro denoting the number of queues in the feedback algorithm. The fb policy of policy.h takes
+  the number of queues and their quanta at runtime and main uses this as the default. */
 #define no_rqs 20
 
+/*Macro denoting the time quantum of the round robin algorithm*/
+#define rr_quantum 1
+
 /********************************************
 Structure Name: 		simInfo
 Author: 				    del_dilettante
@@ -69,10 +89,10 @@ Description:
 class simulation
 {
 public:
-    /* An array of processes that'll be entering the system */
-    process in_proc[sim_size];
+    /* The processes that'll be entering the system */
+    vector<process> in_proc;
     /* The service times for the processes */
-    int     ser_times[sim_size];
+    vector<int>     ser_times;
     /* The TaTs and NorTats for the 4 algos */
     simInfo simInfoInstance;
 
@@ -81,6 +101,15 @@ public:
 
     /* Core logic of the program, simulate scheduling algos */
     simInfo& runSimulation();
+
+    /* Any set of policies run over the same processes */
+    vector<policyInfo> runPolicies(const vector<const policyEntry*>&, const policyConfig&);
+
+    /* The same on many processors */
+    vector<multicoreInfo> runMulticore(const vector<const policyEntry*>&, const policyConfig&, const multicoreConfig&);
+
+    /* Add the results of one algo to the totals */
+    void addTotals(vector<process>&, int);
 };
 
 /********************************************
@@ -91,20 +120,15 @@ Parameters:
 	Defined and their uses commented within the procedure.
 
 Description:
-          The constructor for the simulation class. Takes a vector of ints by reference as an input.
+          The constructor for the simulation class. Takes a vector of ints by reference as an input,
+          the service time of each process, so there are as many processes as times.
 ********************************************/
-simulation::simulation(vector<int>& times)
+simulation::simulation(vector<int>& times) : ser_times(times)
 {
-    /* Instantiate and store 1000 process objects in an array */
-    for (int i = 0; i < sim_size; i++)
-    {
-        ser_times[i] = times[i];
-        char buffer[100];
-        sprintf(buffer, "%d", i);
-        string temp = buffer;
-        process x(temp, 0, ser_times[i]);
-        in_proc[i] = x;
-    }
+    /* Instantiate and store a process object for every service time */
+    in_proc.reserve(ser_times.size());
+    for (size_t i = 0; i < ser_times.size(); i++)
+        in_proc.push_back(process(i, 0, ser_times[i]));
 
     /* Initialise the totals of TaTs and NorTats to 0*/
     for(int i = 0; i < 4; i++)
@@ -124,7 +148,9 @@ Parameters:
 
 Description:
   The core logic of the program. Runs the simulation on a set of 1000 processes using the four
-  scheduling algos, FCFS, RR, HRRN and FB.
+  scheduling algos, FCFS, RR, HRRN and FB. It steps through sim_time time units, which is only
+  enough for all of them to finish with about sim_size processes, so it is kept as the reference
+  the policies are checked against at that size.
 ********************************************/
 
 simInfo& simulation::runSimulation()
@@ -210,7 +236,7 @@ simInfo& simulation::runSimulation()
         /* Common Code region for all algos to add the next process */
         /* For the first 1000 time steps a process arrives at each time step
            Add a copy of the process object to the queues for each algorithm */
-        if(current_time < sim_size)
+        if(current_time < (int)in_proc.size())
         {
             process a = in_proc[proc_counter];
             process b = in_proc[proc_counter];
@@ -366,33 +392,97 @@ simInfo& simulation::runSimulation()
     } //End of core simulation.
 
     /* Update the totals of Tat and NorTat for this sim*/
+    addTotals(fcfs_done, 0);
+    addTotals(rr_done, 1);
+    addTotals(hrrn_done, 2);
+    addTotals(fb_done, 3);
 
-    vector<process>::iterator a = fcfs_done.begin();
-    vector<process>::iterator b = rr_done.begin();
-    vector<process>::iterator c = hrrn_done.begin();
-    vector<process>::iterator d = fb_done.begin();
+    //Return the performance data.
+    return simInfoInstance;
+}
+
+/********************************************
+Procedure Name: 		addTotals(vector<process>&, int)
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	done - The processes that finished, in the order they finished.
+	algo - Index of the algo in the totals.
 
-    //Calculate the total TaTs and NorTaTs of the processes for all four algorithms
-    for (int i = 0; i < sim_size; i++)
+Description:
+  Add the TaTs and NorTats of the processes of one algo to the totals. The NorTats are summed
+  as floats in the order the processes finished.
+********************************************/
+void simulation::addTotals(vector<process>& done, int algo)
+{
+    for (vector<process>::iterator a = done.begin(); a != done.end(); a++)
     {
-        simInfoInstance.totalTat[0] += a->finish_time - a->arrival_time;
-        simInfoInstance.totalTat[1] += b->finish_time - b->arrival_time;
-        simInfoInstance.totalTat[2] += c->finish_time - c->arrival_time;
-        simInfoInstance.totalTat[3] += d->finish_time - d->arrival_time;
-
-        simInfoInstance.totalNorTat[0] += (float)(a->finish_time - a->arrival_time) / a->service_time;
-        simInfoInstance.totalNorTat[1] += (float)(b->finish_time - b->arrival_time) / b->service_time;
-        simInfoInstance.totalNorTat[2] += (float)(c->finish_time - c->arrival_time) / c->service_time;
-        simInfoInstance.totalNorTat[3] += (float)(d->finish_time - d->arrival_time) / d->service_time;
-
-        a++;
-        b++;
-        c++;
-        d++;
+        simInfoInstance.totalTat[algo] += a->finish_time - a->arrival_time;
+        simInfoInstance.totalNorTat[algo] += (float)(a->finish_time - a->arrival_time) / a->service_time;
     }
+}
 
-    //Return the performance data.
-    return simInfoInstance;
+/********************************************
+Procedure Name: 		runPolicies(const vector<const policyEntry*>&, const policyConfig&)
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	which - The policies to run, from the registry in policy.h.
+	c     - The settings to make them with.
+
+Description:
+  Run each of the policies over the processes of the simulation, which arrive one per time unit
+  from time 0 as in runSimulation(), and return the totals of each in the same order. Every
+  policy is made afresh and runs on its own copy of the processes, and how long each took is
+  kept along with its totals.
+********************************************/
+vector<policyInfo> simulation::runPolicies(const vector<const policyEntry*>& which, const policyConfig& c)
+{
+    int n = ser_times.size();
+    processTable t(ser_times.data(), n);
+    for (int i = 0; i < n; i++)
+        t.arrival[i] = i;
+
+    vector<policyInfo> info(which.size());
+    for (size_t i = 0; i < which.size(); i++)
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        unique_ptr<policy> pol = which[i]->make(t, c);
+        info[i] = runPolicy(*pol, t);
+        info[i].seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    return info;
+}
+
+/********************************************
+Procedure Name: 		runMulticore(const vector<const policyEntry*>&, const policyConfig&, const multicoreConfig&)
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	which - The policies to run, from the registry in policy.h.
+	c     - The settings to make them with.
+	mc    - The processors and how they share the load.
+
+Description:
+  Run each of the policies over the processes of the simulation on mc.cores processors, and
+  return the totals of each in the same order. As many processes arrive per time unit as there
+  are processors, so every processor is as loaded as the one of runPolicies().
+********************************************/
+vector<multicoreInfo> simulation::runMulticore(const vector<const policyEntry*>& which, const policyConfig& c, const multicoreConfig& mc)
+{
+    int n = ser_times.size();
+    processTable t(ser_times.data(), n);
+    for (int i = 0; i < n; i++)
+        t.arrival[i] = i / mc.cores;
+
+    vector<multicoreInfo> info(which.size());
+    for (size_t i = 0; i < which.size(); i++)
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        info[i] = ::runMulticore(*which[i], t, c, mc);
+        info[i].totals.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    return info;
 }
 
 
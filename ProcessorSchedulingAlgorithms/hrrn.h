@@ -0,0 +1,197 @@
+/********************************************
+File Name: 			        hrrn.h
+Author: 				        del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+
+Class:
+    hrrnQueue - The processes waiting for an HRRN processor, able to give the one with the
+                highest response ratio at the current time in logarithmic time.
+
+Procedures: Members of the hrrnQueue class.
+
+hrrnQueue(const processTable&, int)
+    - Make an empty queue with room for a number of processes to begin with.
+
+void push(int, int)
+    - Add a process at a given time.
+
+int pop(int)
+    - Remove and return the process with the highest response ratio at a given time.
+
+bool empty(), int size()
+    - Whether the queue is empty, and how many processes are in it.
+********************************************/
+
+#include "process_rds190000.h"
+#ifndef HRRN_RDS190000_H
+#define HRRN_RDS190000_H
+
+#include <climits>
+
+/********************************************
+Class Name: 		    hrrnQueue
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          The response ratio of a process at time t is (t - arrival + service) / service,
+          a line in t with slope 1/service, so which of two processes has the higher ratio
+          only changes once, when the one with the shorter service catches up.
+
+          The queue is a kinetic tournament: a binary tree over slots holding the processes,
+          whose nodes hold the winner of their subtree at the current time, along with the
+          earliest time at which any winner below them changes. Moving the time forward
+          only replays the matches that time has passed, and adding or removing a process
+          replays the matches on the path from it to the root. Time only moves forward, as
+          it does in the simulation. A process takes a free slot when it is added, and the
+          tree doubles when there is none, so its size follows the longest the queue gets
+          rather than the number of processes.
+
+          Ratios are compared exactly, by cross multiplying, and ties go to the lower
+          numbered process, which is the one that arrived first. For the sizes simulated the
+          float ratios of process::getRR() are far enough apart to agree with this.
+********************************************/
+class hrrnQueue
+{
+private:
+    //Arrival and service times of the processes
+    const vector<int32_t>& arrival;
+    const vector<int32_t>& service;
+    //Number of leaves, a power of 2. Node 1 is the root and node leaves + i is slot i.
+    int leaves;
+    //The process in each slot, -1 if it is free, and the free slots
+    vector<int32_t> who;
+    vector<int32_t> freeSlots;
+    //The slot of the winner of each node at the current time, -1 if there is none
+    vector<int32_t> win;
+    //The earliest time at which the winner of a node or any below it changes
+    vector<long long> melt;
+    //The current time, and how many processes are waiting
+    int now;
+    int count;
+
+    static long long floorDiv(long long x, long long d)
+    {
+        return x / d - (x % d < 0 ? 1 : 0);
+    }
+
+    //Replay the match of node i at the current time. Both children must be up to date.
+    void pull(int i)
+    {
+        int l = win[2 * i];
+        int r = win[2 * i + 1];
+        long long m = min(melt[2 * i], melt[2 * i + 1]);
+        if (l < 0 || r < 0)
+        {
+            win[i] = max(l, r);
+            melt[i] = m;
+            return;
+        }
+
+        /* The lower numbered process wins ties */
+        int pl = who[l];
+        int pr = who[r];
+        long long ratioL = (long long)(now - arrival[pl] + service[pl]) * service[pr];
+        long long ratioR = (long long)(now - arrival[pr] + service[pr]) * service[pl];
+        bool leftWins = ratioL != ratioR ? ratioL > ratioR : pl < pr;
+        int w = leftWins ? pl : pr;
+        int los = leftWins ? pr : pl;
+        win[i] = leftWins ? l : r;
+
+        /* The loser only catches up if its service is shorter. It does so at the first t with
+           (t - aL + sL) sW >= (t - aW + sW) sL, or > if it is the higher numbered one, that is
+           t (sW - sL) >= aL sW - aW sL. */
+        if (service[los] < service[w])
+        {
+            long long d = service[w] - service[los];
+            long long x = (long long)arrival[los] * service[w] - (long long)arrival[w] * service[los];
+            long long t = los < w ? -floorDiv(-x, d) : floorDiv(x, d) + 1;
+            m = min(m, t);
+        }
+        melt[i] = m;
+    }
+
+    //Replay every match below node i that time has passed
+    void advance(int i)
+    {
+        if (melt[i] > now)
+            return;
+        advance(2 * i);
+        advance(2 * i + 1);
+        pull(i);
+    }
+
+    void setTime(int t)
+    {
+        now = t;
+        advance(1);
+    }
+
+    //Put process p, or -1, in slot i and replay the matches above it
+    void setSlot(int i, int p)
+    {
+        who[i] = p;
+        win[leaves + i] = p < 0 ? -1 : i;
+        for (i = (leaves + i) / 2; i > 0; i /= 2)
+            pull(i);
+    }
+
+    //Double the number of slots, replaying every match
+    void grow()
+    {
+        int old = leaves;
+        leaves *= 2;
+        who.resize(leaves, -1);
+        win.assign(2 * leaves, -1);
+        melt.assign(2 * leaves, LLONG_MAX);
+        for (int i = leaves - 1; i >= old; i--)
+            freeSlots.push_back(i);
+        for (int i = 0; i < leaves; i++)
+            win[leaves + i] = who[i] < 0 ? -1 : i;
+        for (int i = leaves - 1; i > 0; i--)
+            pull(i);
+    }
+
+public:
+    hrrnQueue(const processTable& t, int capacity = 16) : arrival(t.arrival), service(t.service), now(0), count(0)
+    {
+        leaves = 1;
+        while (leaves < capacity)
+            leaves *= 2;
+        who.assign(leaves, -1);
+        for (int i = leaves - 1; i >= 0; i--)
+            freeSlots.push_back(i);
+        win.assign(2 * leaves, -1);
+        melt.assign(2 * leaves, LLONG_MAX);
+    }
+
+    void push(int p, int t)
+    {
+        setTime(t);
+        if (freeSlots.empty())
+            grow();
+        int i = freeSlots.back();
+        freeSlots.pop_back();
+        setSlot(i, p);
+        count++;
+    }
+
+    int pop(int t)
+    {
+        setTime(t);
+        int i = win[1];
+        int p = who[i];
+        setSlot(i, -1);
+        freeSlots.push_back(i);
+        count--;
+        return p;
+    }
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+};
+
+#endif // HRRN_RDS190000_H
@@ -1,87 +1,135 @@
 /********************************************
 File Name: 			        main.cc
 Author: 				        del_dilettante
-Last Modification Date: 11/8/2020
+Last Modification Date: 10/17/2026
 Last Modifier:          del_dilettante
 Procedures:
 
 	main() : The test porgram that runs the simulations as many times as specified by the 'num_sims' macro in
-  the header file header.h.
+  the header file header.h, unless told otherwise.
+
+  Usage: main [seed] [threads] [levels] [quanta] [policies] [cores] [balance] [interval] [processes] [sims]
+  The simulations run on all cores unless a number of threads is given. The same seed gives the same
+  results on any number of threads. levels is the number of levels of the feedback algo, 20 unless
+  given, and quanta a comma separated list of their time quanta, level 0 first, with the last one
+  used for the rest of the levels. The quanta are 1 unless given. policies is a comma separated list
+  of the policies to compare, from fcfs, rr, hrrn, fb, spn, srt, lottery, stride and cfs, and is the
+  first four unless given. cores is the number of simulated processors, 1 unless given, and
+  balance how they share the load, one of global, migrate and steal, steal unless given. interval
+  is the time between rounds of migration, 4 unless given. With more than one processor the
+  migrations and the use of each processor are reported too. processes is the number of processes
+  in each simulation, sim_size unless given, and sims the number of simulations, num_sims unless
+  given, so that for example
+
+      main 42 1 20 1 hrrn 1 steal 4 1000000 1
+      main 42 1 20 1 fcfs,srt,cfs 128 steal 4 1000000 1
+
+  time HRRN over a backlog of a million processes, and three policies on 128 processors.
 
 ********************************************/
 #include "process_rds190000.h"
 #include "header_rds190000.h"
+#include "montecarlo_rds190000.h"
 
-int main()
+int main(int argc, char** argv)
 {
-    /* Create a vector of int vectors to store the process service times for a 1000 batches of 1000 processes */
-    vector<vector<int> > times(num_sims, vector<int>(sim_size, 0));
-    /* Stores the running total of the means of the Turnaround times for all 4 algos */
-    float total_TatMean[4] = {0};
-    /* Stores the running total of the means of the Normalised Turnaround times for all 4 algos */
-    float total_NorTatMean[4] = {0};
-
-    /*Code to generate normally distributed ints*/
-    for (size_t i = 0; i < num_sims; i++)
+    /* The master seed all the service times are drawn from, random unless given as the first
+       argument so that a run can be repeated */
+    unsigned long long seed = argc > 1 ? strtoull(argv[1], NULL, 10) : ((unsigned long long)random_device()() << 32 | random_device()());
+    /* The number of threads, all cores unless given as the second argument */
+    int threads = argc > 2 ? atoi(argv[2]) : (int)thread::hardware_concurrency();
+    if (threads < 1)
+        threads = 1;
+    /* The number of levels of the feedback algo and their quanta */
+    int levels = argc > 3 ? atoi(argv[3]) : no_rqs;
+    if (levels < 1 || levels > max_rqs)
+    {
+        cerr << "The number of levels must be from 1 to " << max_rqs << endl;
+        return 1;
+    }
+    vector<int> quanta;
+    for (char* q = argc > 4 ? argv[4] : NULL; q != NULL && *q != '\0' && (int)quanta.size() < levels; )
     {
-        /* Initialise a random device */
-        random_device rd;
-        /* Use a mersenne twister PRNG with the seed supplied by the random device */
-        mt19937 gen(rd());
-        /*Create a normal distribution with mean = 10 and standard deviation = 5 */
-        normal_distribution<> dist(10, 5);
-        /*This loop generates a 1000 *approximately* normally distributed ints
-          Values that lie 2 standard devs beyond the mean are discarded. */
-        for (int n = 0; n < sim_size; ++n)
+        quanta.push_back(strtol(q, &q, 10));
+        if (quanta.back() < 1)
         {
-            int x;
-            do
-            {
-              x = round(dist(gen));
-            } while (x < 1 || x > 21);
-            times[i][n] = x;
+            cerr << "Quanta must be at least 1" << endl;
+            return 1;
         }
+        if (*q == ',')
+            q++;
     }
+    quanta.resize(levels, quanta.empty() ? 1 : quanta.back());
 
-    cout << endl << endl;
-
-    /*A string array containing the names of the algos*/
-    string algos[4];
-    algos[0] = "FCFS";
-    algos[1] = "RR";
-    algos[2] = "HRRN";
-    algos[3] = "FB";
+    /* The policies to compare */
+    vector<const policyEntry*> which;
+    string names = argc > 5 ? argv[5] : "fcfs,rr,hrrn,fb";
+    for (size_t at = 0; at <= names.size(); )
+    {
+        size_t comma = names.find(',', at);
+        if (comma == string::npos)
+            comma = names.size();
+        const policyEntry* e = findPolicy(names.substr(at, comma - at));
+        if (e == NULL)
+        {
+            cerr << "Unknown policy " << names.substr(at, comma - at) << endl;
+            return 1;
+        }
+        which.push_back(e);
+        at = comma + 1;
+    }
+    policyConfig c;
+    c.quantum = rr_quantum;
+    c.fb_quanta = quanta;
+    c.seed = 0;
 
+    /* The simulated processors and how they share the load */
+    multicoreConfig mc;
+    mc.cores = argc > 6 ? atoi(argv[6]) : 1;
+    string balance = argc > 7 ? argv[7] : "steal";
+    mc.balance = balance == "global" ? bal_global : balance == "migrate" ? bal_migrate : balance == "steal" ? bal_steal : -1;
+    mc.interval = argc > 8 ? atoi(argv[8]) : 4;
+    if (mc.cores < 1 || mc.balance < 0 || mc.interval < 1)
+    {
+        cerr << "There must be at least 1 core, a balance of global, migrate or steal and an interval of at least 1" << endl;
+        return 1;
+    }
 
-    /*Run the simulation 1000 times*/
-    for (size_t i = 0; i < num_sims; i++)
+    /* The number of processes in each simulation and of simulations */
+    int size = argc > 9 ? atoi(argv[9]) : sim_size;
+    int sims = argc > 10 ? atoi(argv[10]) : num_sims;
+    if (size < 1 || sims < 1)
     {
-        /* Create a simulation object with one of the 1000 vectors of 1000 ints
-           These 1000 ints will serve as the service time for the processes */
-        simulation test(times[i]);
+        cerr << "There must be at least 1 process and 1 simulation" << endl;
+        return 1;
+    }
 
-        /* An instance of the simInfo struct that is used to store the values returned
-            by the simulation instance */
-        simInfo x;
+    /* Run the simulations and total the means of the Turnaround times and Normalised Turnaround
+       times for all the policies */
+    vector<simTotals> totals = runMonteCarlo(sims, size, seed, threads, which, c, mc);
 
-        /* Run the simulation */
-        x = test.runSimulation();
+    cout << endl << endl << "Seed = " << seed << "\n" << endl;
 
-        /* Calculate the mean Tat and mean NorTat for the simulation and add it to the total of means */
-        for (int i = 0; i < 4; i++)
+    /* Calculate the mean of means for all the policies and report the values to draw inferences,
+       along with how fast each ran */
+    for (size_t i = 0; i < which.size(); i++)
+    {
+        string algo = which[i]->name;
+        for (size_t j = 0; j < algo.size(); j++)
+            algo[j] = toupper(algo[j]);
+        cout << "Mean Tat for " << algo << " = " << totals[i].tatMean/sims << "\n"
+             << "Mean NorTat for " << algo << " = " << totals[i].norTatMean/sims << "\n"
+             << "Dispatches per sim for " << algo << " = " << totals[i].dispatches/sims << "\n"
+             << "ns per dispatch for " << algo << " = " << totals[i].seconds * 1e9 / totals[i].dispatches << "\n";
+        if (mc.cores > 1)
         {
-             total_TatMean[i] += (double)x.totalTat[i]/sim_size;
-             total_NorTatMean[i] += (double)x.totalNorTat[i]/sim_size;
+            cout << "Migrations per sim for " << algo << " = " << totals[i].migrations/sims << "\n"
+                 << "Utilization per core for " << algo << " =";
+            for (int k = 0; k < mc.cores; k++)
+                cout << " " << setprecision(3) << totals[i].utilization[k]/sims;
+            cout << setprecision(6) << "\n";
         }
-
-    }
-
-    /* Calculate the mean of means for all the four algorithms and report the values to draw inferences */
-    for (int i = 0; i < 4; i++)
-    {
-        cout << "Mean Tat for " << algos[i] << " = " << (double)total_TatMean[i]/num_sims << "\n"
-             << "Mean NorTat for " << algos[i] << " = " << (double)total_NorTatMean[i]/num_sims << "\n"
-             << endl;
+        cout << endl;
     }
 
     return 0;
@@ -0,0 +1,120 @@
+/********************************************
+File Name: 			        mlfq.h
+Author: 				        del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+
+Class:
+    feedbackQueue - The ready queues of the feedback algorithm, one per priority level, with a
+                    bitmap of the levels that aren't empty.
+
+Procedures: Members of the feedbackQueue class.
+
+feedbackQueue(int, vector<int32_t>&)
+    - Make empty queues for a number of levels, linking processes through an array.
+
+void push(int, int)
+    - Add a process to the back of a level.
+
+int top()
+    - The highest priority level that isn't empty.
+
+int pop(int)
+    - Remove and return the process at the front of a level.
+
+bool empty(), int levels()
+    - Whether every level is empty, and how many levels there are.
+********************************************/
+
+#include "process_rds190000.h"
+#ifndef MLFQ_RDS190000_H
+#define MLFQ_RDS190000_H
+
+#include <cstdint>
+
+/*Macro denoting the most levels a feedbackQueue can have, one bit of the summary per word of
+  the bitmap */
+#define max_rqs 4096
+
+/********************************************
+Class Name: 		    feedbackQueue
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          The levels of the feedback algorithm. Level 0 has the highest priority.
+
+          Each level is a ring of process numbers linked through an array with one entry per
+          process: a process is waiting on at most one level, so the links need no memory of
+          their own, and a level is just the number of its last process, whose link is the
+          first. The array is passed in, so that the queues of many processors can share one,
+          since a process only waits on one of them.
+
+          A bit per level says whether it has any processes and a summary word says which
+          words of bits have any set, so finding the first level with work is two find first
+          set instructions however many levels there are.
+********************************************/
+class feedbackQueue
+{
+private:
+    //The process after each one in the ring of its level
+    vector<int32_t>& next;
+    //The last process of each level, -1 if it is empty
+    vector<int32_t> tail;
+    //A bit for each level that isn't empty, and a bit for each word of them that isn't 0
+    vector<uint64_t> bits;
+    uint64_t summary;
+
+public:
+    feedbackQueue(int levels, vector<int32_t>& links) : next(links), tail(levels, -1), bits((levels + 63) / 64, 0), summary(0) {}
+
+    void push(int level, int p)
+    {
+        int32_t& t = tail[level];
+        if (t < 0)
+        {
+            next[p] = p;
+            bits[level / 64] |= 1ULL << (level % 64);
+            summary |= 1ULL << (level / 64);
+        }
+        else
+        {
+            next[p] = next[t];
+            next[t] = p;
+        }
+        t = p;
+    }
+
+    int top() const
+    {
+        if (summary == 0)
+            return -1;
+        int w = __builtin_ctzll(summary);
+        return w * 64 + __builtin_ctzll(bits[w]);
+    }
+
+    int pop(int level)
+    {
+        int32_t& t = tail[level];
+        int p = next[t];
+        if (p == t)
+        {
+            t = -1;
+            bits[level / 64] &= ~(1ULL << (level % 64));
+            if (bits[level / 64] == 0)
+                summary &= ~(1ULL << (level / 64));
+        }
+        else
+        {
+            next[t] = next[p];
+        }
+        return p;
+    }
+
+    bool empty() const { return summary == 0; }
+    int levels() const { return tail.size(); }
+};
+
+#endif // MLFQ_RDS190000_H
@@ -0,0 +1,192 @@
+/********************************************
+File Name: 			        montecarlo.h
+Author: 				        del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+
+Struct:
+	 simTotals - The sums of the mean TaTs and mean NorTats of a policy over a number of
+	             simulations, with its dispatches, time taken, migrations and use of each
+	             processor.
+
+Procedures:
+
+void serviceTimes(unsigned long long, int, int, vector<int>&)
+    - Fill in the service times of one simulation from its own random stream.
+
+vector<simTotals> runMonteCarlo(int, int, unsigned long long, int, const vector<const policyEntry*>&, const policyConfig&, const multicoreConfig&)
+    - Run a number of simulations spread over a number of threads and add up their means.
+********************************************/
+
+#include "header_rds190000.h"
+#ifndef MONTECARLO_RDS190000_H
+#define MONTECARLO_RDS190000_H
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+
+/*Macro denoting the number of simulations a thread takes at a time*/
+#define sims_per_block 8
+
+/********************************************
+Structure Name: 		simTotals
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+          The sums of the mean TaTs and mean NorTats of one policy over a number of
+          simulations, and of its dispatches and the time it took. On many processors also
+          the sums of its migrations and of the share of each simulation each processor was
+          busy for.
+********************************************/
+struct simTotals
+{
+    /* Sum of the mean TaTs */
+    double tatMean;
+    /* Sum of the mean NorTats */
+    double norTatMean;
+    /* Total dispatches */
+    double dispatches;
+    /* Total time taken in seconds */
+    double seconds;
+    /* Total migrations */
+    double migrations;
+    /* Sum over the simulations of the busy time of each processor over the makespan */
+    vector<double> utilization;
+};
+
+/********************************************
+Procedure Name: 		serviceTimes(unsigned long long, int, int, vector<int>&)
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	seed  - The master seed of the run.
+	sim   - The number of the simulation.
+	size  - The number of processes in it.
+	times - Where their service times go.
+
+Description:
+          Fill in the service times of one simulation. Every simulation seeds its own
+          mersenne twister from the master seed and its number, so its times don't depend
+          on which thread runs it or what ran before. The times are ints drawn from a normal
+          distribution with mean = 10 and standard deviation = 5, with values outside 1..21
+          drawn again.
+********************************************/
+void serviceTimes(unsigned long long seed, int sim, int size, vector<int>& times)
+{
+    seed_seq seq{(unsigned)seed, (unsigned)(seed >> 32), (unsigned)sim};
+    mt19937 gen(seq);
+    normal_distribution<> dist(10, 5);
+    times.resize(size);
+    for (int n = 0; n < size; ++n)
+    {
+        int x;
+        do
+        {
+          x = round(dist(gen));
+        } while (x < 1 || x > 21);
+        times[n] = x;
+    }
+}
+
+/********************************************
+Procedure Name: 		runMonteCarlo(int, int, unsigned long long, int, const vector<const policyEntry*>&, const policyConfig&, const multicoreConfig&)
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	sims    - How many simulations to run.
+	size    - How many processes each has.
+	seed    - The master seed the service times are drawn from.
+	threads - How many threads to run them on.
+	which   - The policies to run in every simulation.
+	c       - The settings to make them with. Its seed is replaced by one for each simulation.
+	mc      - The processors to run them on. With one the policies run with runPolicies(),
+	          and otherwise with runMulticore().
+
+Description:
+          Run the simulations on a number of threads and return the sums of the mean TaTs
+          and NorTats of each policy. The threads take blocks of sims_per_block simulations off
+          a shared counter, generate the service times of each as they go and add the means up
+          into the totals of the block. The blocks are added together in order at the end, so
+          the means only depend on the seed and not on the number of threads or which thread
+          ran which block. The times taken of course do. The migrations and use of the
+          processors are only added up with more than one processor.
+********************************************/
+vector<simTotals> runMonteCarlo(int sims, int size, unsigned long long seed, int threads, const vector<const policyEntry*>& which, const policyConfig& c, const multicoreConfig& mc)
+{
+    int blocks = (sims + sims_per_block - 1) / sims_per_block;
+    simTotals zero = {0, 0, 0, 0, 0, vector<double>(mc.cores, 0)};
+    vector<vector<simTotals> > blockTotals(blocks, vector<simTotals>(which.size(), zero));
+    atomic<int> next(0);
+
+    auto worker = [&]()
+    {
+        vector<int> times;
+        policyConfig sc = c;
+        int b;
+        while ((b = next.fetch_add(1)) < blocks)
+        {
+            vector<simTotals>& t = blockTotals[b];
+            for (int i = b * sims_per_block; i < min(sims, (b + 1) * sims_per_block); i++)
+            {
+                serviceTimes(seed, i, size, times);
+                simulation test(times);
+                sc.seed = (unsigned)(seed ^ (seed >> 32)) + 2654435761u * i;
+                vector<multicoreInfo> m;
+                vector<policyInfo> x;
+                if (mc.cores == 1)
+                {
+                    x = test.runPolicies(which, sc);
+                }
+                else
+                {
+                    m = test.runMulticore(which, sc, mc);
+                    for (size_t j = 0; j < m.size(); j++)
+                        x.push_back(m[j].totals);
+                }
+                for (size_t j = 0; j < which.size(); j++)
+                {
+                    t[j].tatMean += (double)x[j].totalTat / size;
+                    t[j].norTatMean += x[j].totalNorTat / size;
+                    t[j].dispatches += x[j].dispatches;
+                    t[j].seconds += x[j].seconds;
+                    if (mc.cores > 1)
+                    {
+                        t[j].migrations += m[j].migrations;
+                        for (int k = 0; k < mc.cores; k++)
+                            t[j].utilization[k] += (double)m[j].busy[k] / m[j].makespan;
+                    }
+                }
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (int i = 1; i < threads; i++)
+        pool.push_back(thread(worker));
+    //The calling thread works too
+    worker();
+    for (size_t i = 0; i < pool.size(); i++)
+        pool[i].join();
+
+    vector<simTotals> total(which.size(), zero);
+    for (int b = 0; b < blocks; b++)
+    {
+        for (size_t j = 0; j < which.size(); j++)
+        {
+            total[j].tatMean += blockTotals[b][j].tatMean;
+            total[j].norTatMean += blockTotals[b][j].norTatMean;
+            total[j].dispatches += blockTotals[b][j].dispatches;
+            total[j].seconds += blockTotals[b][j].seconds;
+            total[j].migrations += blockTotals[b][j].migrations;
+            for (int k = 0; k < mc.cores; k++)
+                total[j].utilization[k] += blockTotals[b][j].utilization[k];
+        }
+    }
+    return total;
+}
+
+#endif // MONTECARLO_RDS190000_H
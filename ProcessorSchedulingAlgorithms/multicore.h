@@ -0,0 +1,338 @@
+/********************************************
+File Name: 			        multicore.h
+Author: 				        del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+
+Structs:
+	 multicoreConfig - How many processors there are and how the load is balanced among them.
+
+	 multicoreInfo - The totals of one policy on many processors over one simulation.
+
+Procedures:
+
+multicoreInfo runMulticore(const policyEntry&, processTable&, const policyConfig&, const multicoreConfig&)
+    - Run the processes of a table on many processors under a policy.
+********************************************/
+
+#include "policy_rds190000.h"
+#ifndef MULTICORE_RDS190000_H
+#define MULTICORE_RDS190000_H
+
+/*Macros denoting the ways of balancing the load: one ready queue shared by every processor,
+  a queue per processor with processes moved from the longest to the shortest every so often,
+  or a queue per processor with idle processors taking work from the longest */
+#define bal_global 0
+#define bal_migrate 1
+#define bal_steal 2
+
+/********************************************
+Structure Name: 		multicoreConfig
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+          How many processors there are and how the load is balanced among them.
+********************************************/
+struct multicoreConfig
+{
+    /* Number of processors */
+    int cores;
+    /* One of the bal_ macros */
+    int balance;
+    /* Time units between rounds of moving processes, for bal_migrate */
+    int interval;
+};
+
+/********************************************
+Structure Name: 		multicoreInfo
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+          The totals of one policy on many processors over the processes of one simulation.
+********************************************/
+struct multicoreInfo
+{
+    /* TaT, NorTat, dispatches and time taken */
+    policyInfo totals;
+    /* Time units each processor spent running a process */
+    vector<long long> busy;
+    /* Times a process ran on a different processor from the one it last ran on */
+    long long migrations;
+    /* Time the last process finished */
+    int makespan;
+};
+
+/********************************************
+Procedure Name: 		runMulticore(const policyEntry&, processTable&, const policyConfig&, const multicoreConfig&)
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	e  - The policy, from the registry.
+	t  - The processes, with their arrival times in order. Their service left
+	     and finish times are filled in.
+	c  - The settings to make the policy with.
+	mc - The processors and how they share the load.
+
+Description:
+  Run the processes on mc.cores processors under a policy and return the totals. With
+  bal_global there is one policy for all the processors, and otherwise one per processor,
+  with arrivals shared out in turn. The engine works as runPolicy() does, jumping from event
+  to event, and at each time handles:
+    - the arrivals,
+    - the processors whose slice is over,
+    - preemption, of the processor of the queue an arrival joined, or with bal_global of the
+      processor whose process has the most left,
+    - with bal_migrate, every mc.interval time units while anything is ready, a round that
+      pairs the most loaded processors with the least and moves processes between them
+      until their loads differ by at most one,
+    - and last the idle processors picking from their own queue, or with bal_steal from the
+      queue with the most processes ready when theirs is empty.
+  A process moved to another processor is taken off the ready processes of its queue with
+  pick_next() and handed to the other with on_migrate(). An idle processor only looks at its
+  own queue when something joined it, and a thief looks at every queue only when there is
+  something to steal, so a time with nothing to do for most processors costs little however
+  many there are.
+********************************************/
+multicoreInfo runMulticore(const policyEntry& e, processTable& t, const policyConfig& c, const multicoreConfig& mc)
+{
+    int n = t.arrival.size();
+    int P = mc.cores;
+    int queues = mc.balance == bal_global ? 1 : P;
+    vector<int32_t>& left = t.left;
+    left = t.service;
+
+    multicoreInfo info;
+    info.totals.totalTat = 0;
+    info.totals.totalNorTat = 0;
+    info.totals.dispatches = 0;
+    info.totals.seconds = 0;
+    info.busy.assign(P, 0);
+    info.migrations = 0;
+    info.makespan = 0;
+
+    /* The policy of each queue, and how many processes are ready in it */
+    vector<unique_ptr<policy> > pol;
+    for (int i = 0; i < queues; i++)
+        pol.push_back(e.make(t, c));
+    vector<int> ready(queues, 0);
+    long long totalReady = 0;
+
+    /* What each processor is running, since when and until when, and the ends of the slices
+       in order. A slice cut short leaves its end behind, which is skipped. */
+    vector<int> running(P, -1);
+    vector<int> start(P, 0);
+    vector<int> end(P, INT_MAX);
+    priority_queue<pair<int, int>, vector<pair<int, int> >, greater<pair<int, int> > > ends;
+
+    /* The idle processors, with the place of each in the list, -1 if busy */
+    vector<int> idle;
+    vector<int> idlePos(P);
+    for (int i = P - 1; i >= 0; i--)
+    {
+        idlePos[i] = idle.size();
+        idle.push_back(i);
+    }
+    /* Processors to look at in this time because something joined their queue or they
+       stopped, and whether each is in the list */
+    vector<int> wake;
+    vector<char> woken(P, 0);
+    /* The processor each process last ran on */
+    vector<int32_t> lastCore(n, -1);
+    /* Queues that processes arrived in at this time */
+    vector<int> arrivedIn;
+
+    auto queueOf = [&](int core) { return queues == 1 ? 0 : core; };
+    auto wakeUp = [&](int core)
+    {
+        if (!woken[core])
+        {
+            woken[core] = 1;
+            wake.push_back(core);
+        }
+    };
+    auto leaveIdle = [&](int core)
+    {
+        int last = idle.back();
+        idle[idlePos[core]] = last;
+        idlePos[last] = idlePos[core];
+        idle.pop_back();
+        idlePos[core] = -1;
+    };
+
+    //Run process p, just taken off a queue, on an idle processor
+    auto dispatch = [&](int core, int p, int slice, int now)
+    {
+        leaveIdle(core);
+        running[core] = p;
+        start[core] = now;
+        end[core] = now + min(slice, (int)left[p]);
+        ends.push(make_pair(end[core], core));
+        info.totals.dispatches++;
+        if (lastCore[p] >= 0 && lastCore[p] != core)
+            info.migrations++;
+        lastCore[p] = core;
+    };
+
+    //Take the next process off queue q, -1 if there is none
+    auto take = [&](int q, int now, int& slice)
+    {
+        int p = pol[q]->pick_next(now, slice);
+        if (p >= 0)
+        {
+            ready[q]--;
+            totalReady--;
+        }
+        return p;
+    };
+
+    //Stop the process running on a processor, finished or not
+    auto stop = [&](int core, int now)
+    {
+        int p = running[core];
+        int ran = now - start[core];
+        info.busy[core] += ran;
+        left[p] -= ran;
+        running[core] = -1;
+        end[core] = INT_MAX;
+        idlePos[core] = idle.size();
+        idle.push_back(core);
+        wakeUp(core);
+        if (left[p] == 0)
+        {
+            t.finish[p] = now;
+            info.totals.totalTat += now - t.arrival[p];
+            info.totals.totalNorTat += (double)(now - t.arrival[p]) / t.service[p];
+            info.makespan = now;
+            return true;
+        }
+        pol[queueOf(core)]->on_tick(p, ran, now);
+        ready[queueOf(core)]++;
+        totalReady++;
+        return false;
+    };
+
+    //Move a ready process from one queue to another
+    auto move = [&](int from, int to, int now)
+    {
+        int slice;
+        int p = take(from, now, slice);
+        pol[to]->on_migrate(p, now);
+        ready[to]++;
+        totalReady++;
+    };
+
+    int next = 0;
+    int finished = 0;
+    int nextBalance = mc.interval;
+    vector<int> order(P);
+    while (finished < n)
+    {
+        int now = next < n ? (int)t.arrival[next] : INT_MAX;
+        if (!ends.empty())
+            now = min(now, ends.top().first);
+        if (mc.balance == bal_migrate && totalReady > 0)
+            now = min(now, nextBalance);
+
+        /* Arrivals */
+        arrivedIn.clear();
+        for (; next < n && t.arrival[next] == now; next++)
+        {
+            int q = queueOf(next % P);
+            pol[q]->on_arrival(next, now);
+            ready[q]++;
+            totalReady++;
+            arrivedIn.push_back(q);
+            if (mc.balance != bal_global)
+                wakeUp(q);
+        }
+
+        /* Slices that are over */
+        while (!ends.empty() && ends.top().first == now)
+        {
+            int core = ends.top().second;
+            ends.pop();
+            if (running[core] >= 0 && end[core] == now && stop(core, now))
+                finished++;
+        }
+
+        /* Preemption by the arrivals */
+        for (size_t i = 0; i < arrivedIn.size(); i++)
+        {
+            int core = arrivedIn[i];
+            if (queues == 1)
+            {
+                core = -1;
+                for (int j = 0; j < P; j++)
+                {
+                    if (running[j] >= 0 && (core < 0 || left[running[j]] - (now - start[j]) > left[running[core]] - (now - start[core])))
+                        core = j;
+                }
+            }
+            if (core >= 0 && running[core] >= 0 && pol[queueOf(core)]->preempts(running[core], left[running[core]] - (now - start[core]), now))
+                stop(core, now);
+        }
+
+        /* Migration between the queues */
+        if (mc.balance == bal_migrate && now == nextBalance && totalReady > 0)
+        {
+            for (int i = 0; i < P; i++)
+                order[i] = i;
+            auto load = [&](int core) { return ready[core] + (running[core] >= 0 ? 1 : 0); };
+            sort(order.begin(), order.end(), [&](int a, int b) { return load(a) > load(b) || (load(a) == load(b) && a < b); });
+            for (int i = 0, j = P - 1; i < j; i++, j--)
+            {
+                while (load(order[i]) - load(order[j]) > 1 && ready[order[i]] > 0)
+                {
+                    move(order[i], order[j], now);
+                    wakeUp(order[j]);
+                }
+            }
+        }
+        //The next round is at the next multiple of the interval
+        if (nextBalance <= now)
+            nextBalance = (now / mc.interval + 1) * mc.interval;
+
+        /* Idle processors pick from their own queue */
+        for (size_t i = 0; i < wake.size(); i++)
+        {
+            int core = wake[i];
+            woken[core] = 0;
+            int q = queueOf(core);
+            int slice;
+            int p;
+            if (running[core] < 0 && ready[q] > 0 && (p = take(q, now, slice)) >= 0)
+                dispatch(core, p, slice, now);
+        }
+        wake.clear();
+
+        /* With one queue the processors that didn't stop pick from it too, and with stealing
+           the idle ones take from the longest queue */
+        while (!idle.empty() && totalReady > 0 && mc.balance != bal_migrate)
+        {
+            int core = idle.back();
+            int q = queueOf(core);
+            if (ready[q] == 0)
+            {
+                int victim = 0;
+                for (int j = 1; j < queues; j++)
+                {
+                    if (ready[j] > ready[victim])
+                        victim = j;
+                }
+                move(victim, q, now);
+            }
+            int slice;
+            int p = take(q, now, slice);
+            dispatch(core, p, slice, now);
+        }
+    }
+    return info;
+}
+
+#endif // MULTICORE_RDS190000_H
@@ -0,0 +1,723 @@
+/********************************************
+File Name: 			        policy.h
+Author: 				        del_dilettante
+Last Modification Date: 10/17/2026
+Last Modifier:          del_dilettante
+
+Structs:
+	 policyConfig - The settings the policies are made with.
+
+	 policyInfo - The totals of one policy over one simulation.
+
+	 policyEntry - The name of a policy and how to make one.
+
+Classes:
+    policy - The interface of a scheduling policy, called by runPolicy() as processes arrive,
+             run and are picked.
+
+    fcfsPolicy, rrPolicy, hrrnPolicy, fbPolicy - The four algos of runSimulation().
+
+    spnPolicy, srtPolicy - Shortest process next and shortest remaining time, from a heap.
+
+    lotteryPolicy - Draws the next process, each holding tickets, from a Fenwick tree.
+
+    stridePolicy - Runs the process with the lowest pass, from a heap.
+
+    cfsPolicy - Runs the process with the least virtual runtime, from a red black tree.
+
+Procedures:
+
+policyInfo runPolicy(policy&, processTable&)
+    - Run the processes of a table on one processor under a policy.
+
+const policyEntry* findPolicy(const string&)
+    - Look a policy up in the registry by name.
+
+Procedures: Members of the policy class.
+
+void on_arrival(int, int)
+    - A process has arrived and is ready.
+
+void on_tick(int, int, int)
+    - A process has run for some time units without finishing and is ready again.
+
+int pick_next(int, int&)
+    - Take the process to run next off the ready processes, and say for how long.
+
+bool preempts(int, int, int)
+    - Whether the running process should stop for a process that just arrived.
+
+void on_migrate(int, int)
+    - A process has moved here from the ready processes of another processor.
+********************************************/
+
+#include "process_rds190000.h"
+#include "hrrn_rds190000.h"
+#include "mlfq_rds190000.h"
+#ifndef POLICY_RDS190000_H
+#define POLICY_RDS190000_H
+
+#include <climits>
+#include <memory>
+#include <set>
+
+/*Macro denoting the tickets shared out to a process by lottery and stride, divided by its
+  service time so that short processes get more */
+#define ticket_pool 1000
+
+/*Macro denoting the pass that stride adds for a process holding one ticket per time unit*/
+#define stride_one (1 << 20)
+
+/*Macros denoting the time in which the CFS like policy tries to run every ready process once,
+  and the shortest slice it gives */
+#define cfs_latency 20
+#define cfs_granularity 1
+
+/********************************************
+Structure Name: 		policyConfig
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+          The settings the policies are made with. Each policy reads the ones it needs.
+********************************************/
+struct policyConfig
+{
+    /* Time quantum of rr, lottery and stride */
+    int quantum;
+    /* Time quantum of each level of fb, level 0 first */
+    vector<int> fb_quanta;
+    /* Seed of the random draws of lottery */
+    unsigned seed;
+};
+
+/********************************************
+Structure Name: 		policyInfo
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+          The totals of one policy over the processes of one simulation.
+********************************************/
+struct policyInfo
+{
+    /* Total TaT */
+    long long totalTat;
+    /* Total NorTat */
+    double totalNorTat;
+    /* How many times a process was picked to run */
+    long long dispatches;
+    /* How long the run took in seconds, making the policy included */
+    double seconds;
+};
+
+/********************************************
+Class Name: 		    policy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          A scheduling policy: it holds the processes that are ready and decides which one
+          runs next and for how long. runPolicy() owns the processor and the clock and tells
+          the policy about arrivals and processes that stop before finishing. A process
+          that finishes is simply not handed back.
+
+          A policy keeps nothing per process of its own, only the fields of the processTable
+          meant for ready queues, so runMulticore() can give every processor its own policy
+          without a copy of every process for each.
+********************************************/
+class policy
+{
+public:
+    virtual ~policy() {}
+
+    /* Process p arrived at time now and is ready */
+    virtual void on_arrival(int p, int now) = 0;
+
+    /* Process p ran for ran time units up to now, used up its slice or was preempted without
+       finishing, and is ready again */
+    virtual void on_tick(int p, int ran, int now) = 0;
+
+    /* Take the process to run at time now off the ready processes and set slice to the most
+       time units it may run for. Returns -1 if no process is ready. */
+    virtual int pick_next(int now, int& slice) = 0;
+
+    /* Whether the running process p, with left time units of service left, should stop at
+       time now for a process that has just arrived */
+    virtual bool preempts(int, int, int) { return false; }
+
+    /* Process p, taken off the ready processes of another processor by its pick_next(), is
+       ready here. By default it joins as if its slice had just ended after no time. */
+    virtual void on_migrate(int p, int now) { on_tick(p, 0, now); }
+};
+
+/********************************************
+Procedure Name: 		runPolicy(policy&, processTable&)
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	pol - The policy.
+	t   - The processes, with their arrival times in order. Their service left
+	      and finish times are filled in.
+
+Description:
+  Run the processes on one processor under a policy and return the totals. The engine jumps
+  from event to event: the next arrival, or the end of the slice of the running process.
+  At each time the arrivals come first, then the running process stops if its slice is over
+  or the policy preempts it, then the policy picks a process if the processor is free. A
+  process picked at time t and run for s time units finishes at t + s, which for the four
+  algos of runSimulation() gives the same totals whenever their processors are never idle,
+  as in the simulations run by main.
+********************************************/
+policyInfo runPolicy(policy& pol, processTable& t)
+{
+    int n = t.arrival.size();
+    vector<int32_t>& left = t.left;
+    left = t.service;
+    policyInfo info = {0, 0, 0, 0};
+
+    int next = 0;
+    int finished = 0;
+    //The running process, when it started its slice and when the slice ends
+    int running = -1;
+    int start = 0;
+    int end = INT_MAX;
+    while (finished < n)
+    {
+        int now = min(next < n ? (int)t.arrival[next] : INT_MAX, end);
+
+        bool arrived = false;
+        for (; next < n && t.arrival[next] == now; next++)
+        {
+            pol.on_arrival(next, now);
+            arrived = true;
+        }
+
+        if (running >= 0 && (now == end || (arrived && pol.preempts(running, left[running] - (now - start), now))))
+        {
+            left[running] -= now - start;
+            if (left[running] == 0)
+            {
+                t.finish[running] = now;
+                info.totalTat += now - t.arrival[running];
+                info.totalNorTat += (double)(now - t.arrival[running]) / t.service[running];
+                finished++;
+            }
+            else
+            {
+                pol.on_tick(running, now - start, now);
+            }
+            running = -1;
+            end = INT_MAX;
+        }
+
+        if (running < 0)
+        {
+            int slice;
+            running = pol.pick_next(now, slice);
+            if (running >= 0)
+            {
+                start = now;
+                end = now + min(slice, (int)left[running]);
+                info.dispatches++;
+            }
+        }
+    }
+    return info;
+}
+
+/********************************************
+Class Name: 		    fcfsPolicy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          First come first served, from a queue of process numbers.
+********************************************/
+class fcfsPolicy : public policy
+{
+private:
+    indexQueue q;
+
+public:
+    fcfsPolicy(processTable&, const policyConfig&) : q(16) {}
+
+    void on_arrival(int p, int) { q.push(p); }
+    void on_tick(int p, int, int) { q.push(p); }
+
+    int pick_next(int, int& slice)
+    {
+        if (q.empty())
+            return -1;
+        int p = q.front();
+        q.pop();
+        slice = INT_MAX;
+        return p;
+    }
+};
+
+/********************************************
+Class Name: 		    rrPolicy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          Round robin, from a queue of process numbers. A process whose slice ends goes to the
+          back, behind the processes that arrived at the same time.
+********************************************/
+class rrPolicy : public policy
+{
+private:
+    indexQueue q;
+    int quantum;
+
+public:
+    rrPolicy(processTable&, const policyConfig& c) : q(16), quantum(c.quantum) {}
+
+    void on_arrival(int p, int) { q.push(p); }
+    void on_tick(int p, int, int) { q.push(p); }
+
+    int pick_next(int, int& slice)
+    {
+        if (q.empty())
+            return -1;
+        int p = q.front();
+        q.pop();
+        slice = quantum;
+        return p;
+    }
+};
+
+/********************************************
+Class Name: 		    hrrnPolicy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          Highest response ratio next, from an hrrnQueue.
+********************************************/
+class hrrnPolicy : public policy
+{
+private:
+    hrrnQueue q;
+
+public:
+    hrrnPolicy(processTable& t, const policyConfig&) : q(t) {}
+
+    void on_arrival(int p, int now) { q.push(p, now); }
+    void on_tick(int p, int, int now) { q.push(p, now); }
+
+    int pick_next(int now, int& slice)
+    {
+        if (q.empty())
+            return -1;
+        slice = INT_MAX;
+        return q.pop(now);
+    }
+};
+
+/********************************************
+Class Name: 		    fbPolicy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          Feedback, from a feedbackQueue linked through the table. A process that uses up the
+          quantum of its level drops to the next one, and stays on the last. A process that
+          moves here from another processor keeps its level.
+********************************************/
+class fbPolicy : public policy
+{
+private:
+    feedbackQueue rq;
+    vector<int> quanta;
+    //The level each process is on
+    vector<int32_t>& level;
+
+public:
+    fbPolicy(processTable& t, const policyConfig& c) : rq(c.fb_quanta.size(), t.link), quanta(c.fb_quanta), level(t.level) {}
+
+    void on_arrival(int p, int)
+    {
+        level[p] = 0;
+        rq.push(0, p);
+    }
+
+    void on_tick(int p, int, int)
+    {
+        level[p] = min(level[p] + 1, (int32_t)quanta.size() - 1);
+        rq.push(level[p], p);
+    }
+
+    void on_migrate(int p, int) { rq.push(level[p], p); }
+
+    int pick_next(int, int& slice)
+    {
+        int l = rq.top();
+        if (l < 0)
+            return -1;
+        slice = quanta[l];
+        return rq.pop(l);
+    }
+};
+
+/********************************************
+Class Name: 		    spnPolicy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          Shortest process next: the ready process with the least service runs to the end.
+          The heap holds the service time and number of a process in one 64 bit key, so
+          ties go to the one that arrived first.
+********************************************/
+class spnPolicy : public policy
+{
+private:
+    const vector<int32_t>& service;
+    priority_queue<unsigned long long, vector<unsigned long long>, greater<unsigned long long> > heap;
+
+public:
+    spnPolicy(processTable& t, const policyConfig&) : service(t.service) {}
+
+    void on_arrival(int p, int) { heap.push((unsigned long long)service[p] << 32 | p); }
+    void on_tick(int p, int, int) { on_arrival(p, 0); }
+
+    int pick_next(int, int& slice)
+    {
+        if (heap.empty())
+            return -1;
+        int p = heap.top() & 0xffffffff;
+        heap.pop();
+        slice = INT_MAX;
+        return p;
+    }
+};
+
+/********************************************
+Class Name: 		    srtPolicy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          Shortest remaining time: the ready process with the least service left runs, and
+          an arrival that needs less than the running process has left takes its place. The
+          heap is keyed like that of spnPolicy, on the service left, which is kept in the key
+          of the table.
+********************************************/
+class srtPolicy : public policy
+{
+private:
+    //The service each process has left, as of when it last stopped
+    vector<long long>& left;
+    const vector<int32_t>& service;
+    priority_queue<unsigned long long, vector<unsigned long long>, greater<unsigned long long> > heap;
+
+    void push(int p) { heap.push((unsigned long long)left[p] << 32 | p); }
+
+public:
+    srtPolicy(processTable& t, const policyConfig&) : left(t.key), service(t.service) {}
+
+    void on_arrival(int p, int)
+    {
+        left[p] = service[p];
+        push(p);
+    }
+
+    void on_tick(int p, int ran, int)
+    {
+        left[p] -= ran;
+        push(p);
+    }
+
+    int pick_next(int, int& slice)
+    {
+        if (heap.empty())
+            return -1;
+        int p = heap.top() & 0xffffffff;
+        heap.pop();
+        slice = INT_MAX;
+        return p;
+    }
+
+    bool preempts(int, int leftNow, int) { return !heap.empty() && (long long)(heap.top() >> 32) < leftNow; }
+};
+
+/********************************************
+Class Name: 		    lotteryPolicy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          Lottery scheduling: every quantum a ticket is drawn from those of the ready
+          processes and its holder runs. A process holds ticket_pool / service tickets. The
+          ready processes sit in slots, and the tickets of the slots are kept in a Fenwick
+          tree, so a process joins or leaves the draw, and the holder of a ticket is found,
+          in logarithmic time. The slots double when they run out, so their number follows
+          the most processes ready at once.
+********************************************/
+class lotteryPolicy : public policy
+{
+private:
+    const vector<int32_t>& service;
+    //The process in each slot, and the free slots
+    vector<int32_t> who;
+    vector<int32_t> freeSlots;
+    //The Fenwick tree of the tickets in the slots, 1 based, and their sum
+    vector<long long> tree;
+    long long total;
+    mt19937_64 gen;
+    int quantum;
+
+    long long tickets(int p) const { return max(1, ticket_pool / service[p]); }
+
+    void add(int slot, long long x)
+    {
+        total += x;
+        for (int i = slot + 1; i < (int)tree.size(); i += i & -i)
+            tree[i] += x;
+    }
+
+    //The slot holding ticket r, counting the tickets of the slots in order
+    int holder(long long r) const
+    {
+        int i = 0;
+        for (int step = who.size(); step > 0; step /= 2)
+        {
+            if (i + step < (int)tree.size() && tree[i + step] <= r)
+            {
+                i += step;
+                r -= tree[i];
+            }
+        }
+        return i;
+    }
+
+    //Double the number of slots and rebuild the tree
+    void grow()
+    {
+        int old = who.size();
+        who.resize(2 * old, -1);
+        for (int i = 2 * old - 1; i >= old; i--)
+            freeSlots.push_back(i);
+        tree.assign(2 * old + 1, 0);
+        total = 0;
+        for (int i = 0; i < old; i++)
+            add(i, tickets(who[i]));
+    }
+
+public:
+    lotteryPolicy(processTable& t, const policyConfig& c)
+        : service(t.service), who(16, -1), tree(17, 0), total(0), gen(c.seed), quantum(c.quantum)
+    {
+        for (int i = 15; i >= 0; i--)
+            freeSlots.push_back(i);
+    }
+
+    void on_arrival(int p, int)
+    {
+        if (freeSlots.empty())
+            grow();
+        int i = freeSlots.back();
+        freeSlots.pop_back();
+        who[i] = p;
+        add(i, tickets(p));
+    }
+
+    void on_tick(int p, int, int now) { on_arrival(p, now); }
+
+    int pick_next(int, int& slice)
+    {
+        if (total == 0)
+            return -1;
+        int i = holder(uniform_int_distribution<long long>(0, total - 1)(gen));
+        int p = who[i];
+        add(i, -tickets(p));
+        freeSlots.push_back(i);
+        slice = quantum;
+        return p;
+    }
+};
+
+/********************************************
+Class Name: 		    stridePolicy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          Stride scheduling, the deterministic form of lottery: a process with the tickets
+          of lotteryPolicy has a stride of stride_one / tickets and a pass, kept in the key
+          of the table, that grows by its stride for each time unit it runs. The ready
+          process with the lowest pass runs next, from a heap keyed on the pass. An arrival
+          starts at the pass of the last process picked, so it gets no credit for the time
+          before it arrived.
+********************************************/
+class stridePolicy : public policy
+{
+private:
+    const vector<int32_t>& service;
+    vector<long long>& pass;
+    priority_queue<pair<long long, int>, vector<pair<long long, int> >, greater<pair<long long, int> > > heap;
+    //The pass of the last process picked
+    long long global;
+    int quantum;
+
+public:
+    stridePolicy(processTable& t, const policyConfig& c) : service(t.service), pass(t.key), global(0), quantum(c.quantum) {}
+
+    void on_arrival(int p, int)
+    {
+        pass[p] = global;
+        heap.push(make_pair(pass[p], p));
+    }
+
+    void on_tick(int p, int ran, int)
+    {
+        pass[p] += (long long)stride_one / max(1, ticket_pool / service[p]) * ran;
+        heap.push(make_pair(pass[p], p));
+    }
+
+    int pick_next(int, int& slice)
+    {
+        if (heap.empty())
+            return -1;
+        int p = heap.top().second;
+        global = heap.top().first;
+        heap.pop();
+        slice = quantum;
+        return p;
+    }
+};
+
+/********************************************
+Class Name: 		    cfsPolicy
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          A fair scheduler after the completely fair scheduler of Linux. Every process has a
+          virtual runtime, kept in the key of the table, that grows by the time it runs, and
+          the ready process with the least runs next, for cfs_latency shared among the ready
+          processes but at least cfs_granularity. The ready processes are kept in a set, a red
+          black tree, ordered on virtual runtime and then number. An arrival, or a process
+          moving here from another processor, starts at the least virtual runtime seen here,
+          so it neither starves the others nor is starved.
+********************************************/
+class cfsPolicy : public policy
+{
+private:
+    vector<long long>& vruntime;
+    set<pair<long long, int> > tree;
+    long long min_vruntime;
+
+public:
+    cfsPolicy(processTable& t, const policyConfig&) : vruntime(t.key), min_vruntime(0) {}
+
+    void on_arrival(int p, int)
+    {
+        vruntime[p] = min_vruntime;
+        tree.insert(make_pair(vruntime[p], p));
+    }
+
+    void on_tick(int p, int ran, int)
+    {
+        vruntime[p] += ran;
+        tree.insert(make_pair(vruntime[p], p));
+    }
+
+    void on_migrate(int p, int now) { on_arrival(p, now); }
+
+    int pick_next(int, int& slice)
+    {
+        if (tree.empty())
+            return -1;
+        int p = tree.begin()->second;
+        min_vruntime = max(min_vruntime, tree.begin()->first);
+        tree.erase(tree.begin());
+        slice = max(cfs_granularity, cfs_latency / (int)(tree.size() + 1));
+        return p;
+    }
+};
+
+/********************************************
+Structure Name: 		policyEntry
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the struct.
+
+Description:
+          An entry of the registry of policies: a name and a procedure that makes the policy
+          for the processes of a table.
+********************************************/
+struct policyEntry
+{
+    const char* name;
+    unique_ptr<policy> (*make)(processTable&, const policyConfig&);
+};
+
+template <class P>
+unique_ptr<policy> makePolicy(processTable& t, const policyConfig& c)
+{
+    return unique_ptr<policy>(new P(t, c));
+}
+
+/* The registry, in the order main lists them */
+const policyEntry policies[] =
+{
+    {"fcfs", makePolicy<fcfsPolicy>},
+    {"rr", makePolicy<rrPolicy>},
+    {"hrrn", makePolicy<hrrnPolicy>},
+    {"fb", makePolicy<fbPolicy>},
+    {"spn", makePolicy<spnPolicy>},
+    {"srt", makePolicy<srtPolicy>},
+    {"lottery", makePolicy<lotteryPolicy>},
+    {"stride", makePolicy<stridePolicy>},
+    {"cfs", makePolicy<cfsPolicy>},
+};
+
+/********************************************
+Procedure Name: 		findPolicy(const string&)
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	name - The name of a policy.
+
+Description:
+  The entry of the registry with the given name, NULL if there is none.
+********************************************/
+const policyEntry* findPolicy(const string& name)
+{
+    for (size_t i = 0; i < sizeof(policies) / sizeof(policies[0]); i++)
+    {
+        if (name == policies[i].name)
+            return &policies[i];
+    }
+    return NULL;
+}
+
+#endif // POLICY_RDS190000_H
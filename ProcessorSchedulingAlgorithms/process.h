@@ -1,28 +1,37 @@
 /********************************************
 File Name: 			        process.h
 Author: 				        del_dilettante
-Last Modification Date: 11/8/2020
+Last Modification Date: 10/17/2026
 Last Modifier:          del_dilettante
 
 Class:
-    process - An object that holds the information for a process.
+    process - A plain record that holds the information for a process.
+
+    indexQueue - A first in first out queue of process numbers in a ring buffer.
+
+Struct:
+    processTable - The processes of a simulation as one array per field.
 
 Procedures: Members of the process class.
 
 process()
     - The default constructor for process class
 
-process(string, int, int)
+process(int, int, int)
     - The parametric constructor for process class
 
-process(const process&)
-    - The copy constructor for process class
-
 float getRR();
     - A getter method to calculate the response ratio for a process
 
-process& operator=(const process&);
-    - A copy assignment operator for the process class.
+Procedures: Members of the processTable struct.
+
+processTable(const int*, int)
+    - Set up the table for a number of processes with the given service times.
+
+Procedures: Members of the indexQueue class.
+
+void push(int), void pop(), int front(), bool empty(), int size()
+    - The usual queue operations.
 ********************************************/
 
 #ifndef PROCESS_RDS190000_H
@@ -36,6 +45,8 @@ process& operator=(const process&);
 #include <map>
 #include <random>
 #include <fstream>
+#include <cstdint>
+#include <algorithm>
 using namespace std;
 
 /********************************************
@@ -46,40 +57,35 @@ Parameters:
 	Defined and their uses commented within the struct.
 
 Description:
-          An object that holds the information for a process.
+          An object that holds the information for a process. It is a plain record of
+          32 bit ints with no owned memory, so copying or moving one is a copy of 28 bytes.
 ********************************************/
 class process
 {
 public:
     //Unique id for the process
-    string pid;
+    int32_t pid;
     //Time when it arrived in the system
-    int arrival_time;
+    int32_t arrival_time;
     //Time when it finished executing
-    int finish_time;
+    int32_t finish_time;
     //How many total time units of service will it need
-    int service_time;
+    int32_t service_time;
     //The turnaround time for the process
-    int ta_time;
+    int32_t ta_time;
     //How many time units of service left
-    int service_left;
+    int32_t service_left;
     //How long has the process been waiting before execution
-    int wait_time;
+    int32_t wait_time;
 
     // Default Constructor
     process();
 
     // Parametric Constructor
-    process(string, int, int);
-
-    // Copy Constructor
-    process(const process&);
+    process(int, int, int);
 
     // Get Response Ratio
     float getRR();
-
-    // Overloaded Assigment Operator.
-    process& operator=(const process&);
 };
 
 /********************************************
@@ -94,7 +100,7 @@ Description:
 ********************************************/
 process::process()
 {
-    pid = "";
+    pid = 0;
     arrival_time = 0;
     finish_time = 0;
     service_left = 0;
@@ -105,17 +111,17 @@ process::process()
 
 
 /********************************************
-Procedure Name: 		process(string, int, int)
+Procedure Name: 		process(int, int, int)
 Author: 				    del_dilettante
-Date: 					    11/8/2020
+Date: 					    10/17/2026
 Parameters:
 	Defined and their uses commented within the procedure.
 
 Description:
-          The parametric constructor for the process class. Takes in a process id string,
+          The parametric constructor for the process class. Takes in a process id,
           along with arrival time and service time ints.
 ********************************************/
-process::process(string x, int at, int st)
+process::process(int x, int at, int st)
 {
     pid = x;
     arrival_time = at;
@@ -127,66 +133,128 @@ process::process(string x, int at, int st)
 }
 
 /********************************************
-Procedure Name: 		process(const process&)
+Procedure Name: 		getRR()
 Author: 				    del_dilettante
 Date: 					    11/8/2020
 Parameters:
 	Defined and their uses commented within the procedure.
 
 Description:
-          The copy constructor for the process class. Takes in a const reference
-          to the process that is to be copied.
+          A getter method to calculate the response ratio for a process.
+          Return the response ratio as a float value.
 ********************************************/
-process::process(const process& x)
+float process::getRR()
 {
-    pid = x.pid;
-    arrival_time = x.arrival_time;
-    finish_time = x.finish_time;
-    service_left = x.service_left;
-    service_time = x.service_time;
-    ta_time = x.ta_time;
-    wait_time = x.wait_time;
+    return (float) (wait_time + service_time)/service_time;
 }
 
 /********************************************
-Procedure Name: 		getRR()
+Structure Name: 		processTable
 Author: 				    del_dilettante
-Date: 					    11/8/2020
+Date: 					    10/17/2026
 Parameters:
-	Defined and their uses commented within the procedure.
+	Defined and their uses commented within the struct.
 
 Description:
-          A getter method to calculate the response ratio for a process.
-          Return the response ratio as a float value.
+          The processes of a simulation stored by field, one array each, and indexed by
+          process number. Queues hold process numbers, so moving a process between queues
+          moves one int. A policy run by runPolicy() or runMulticore() fills in the
+          service left and finish times, which every run sets afresh.
+
+          The last three fields belong to whichever ready queue holds a process. A process
+          waits in one queue at a time, so the run queues of many processors can share them
+          and need no memory per process of their own.
 ********************************************/
-float process::getRR()
+struct processTable
 {
-    return (float) (wait_time + service_time)/service_time;
-}
+    //Time when each process arrived in the system
+    vector<int32_t> arrival;
+    //How many total time units of service each needs
+    vector<int32_t> service;
+    //How many time units of service each has left
+    vector<int32_t> left;
+    //Time when each finished executing
+    vector<int32_t> finish;
+    //The next process in the ring of the feedbackQueue level each is on
+    vector<int32_t> link;
+    //The feedback level each is on
+    vector<int32_t> level;
+    //The key each is ordered on by the heap or tree it is in
+    vector<long long> key;
+
+    processTable(const int*, int);
+};
 
 /********************************************
-Procedure Name: 		process::operator=(const process&)
+Procedure Name: 		processTable(const int*, int)
 Author: 				    del_dilettante
-Date: 					    11/8/2020
+Date: 					    10/17/2026
 Parameters:
-	Defined and their uses commented within the procedure.
+	times - The service times of the processes.
+	n     - The number of processes.
 
 Description:
-          A copy assignment operator for the process class.
-          Returns a reference to the process object to which
-          the input const process was copied.
+          Set up the table. The arrival times are filled in as the processes arrive.
 ********************************************/
-process& process::operator=(const process& x)
+processTable::processTable(const int* times, int n)
+    : arrival(n, 0), service(times, times + n), left(service), finish(n, 0), link(n, 0), level(n, 0), key(n, 0)
 {
-    pid = x.pid;
-    arrival_time = x.arrival_time;
-    finish_time = x.finish_time;
-    service_left = x.service_left;
-    service_time = x.service_time;
-    ta_time = x.ta_time;
-    wait_time = x.wait_time;
-    return *this;
 }
 
+/********************************************
+Class Name: 		    indexQueue
+Author: 				    del_dilettante
+Date: 					    10/17/2026
+Parameters:
+	Defined and their uses commented within the class.
+
+Description:
+          A first in first out queue of process numbers in a ring buffer. A process is never
+          in the same queue twice, so the number of processes is always enough room, but the
+          ring starts at the capacity asked for and doubles when it is full, so a queue that
+          stays short stays small.
+********************************************/
+class indexQueue
+{
+private:
+    //The ring buffer
+    vector<int32_t> ring;
+    //Where the front is, and how many there are
+    int head;
+    int count;
+
+public:
+    indexQueue(int capacity = 0) : ring(capacity), head(0), count(0) {}
+
+    void push(int x)
+    {
+        if (count == (int)ring.size())
+        {
+            //Unroll the ring into one twice the size
+            vector<int32_t> bigger(max(16, 2 * count));
+            for (int i = 0; i < count; i++)
+                bigger[i] = ring[(head + i) % count];
+            ring.swap(bigger);
+            head = 0;
+        }
+        int tail = head + count;
+        if (tail >= (int)ring.size())
+            tail -= ring.size();
+        ring[tail] = x;
+        count++;
+    }
+
+    void pop()
+    {
+        if (++head == (int)ring.size())
+            head = 0;
+        count--;
+    }
+
+    int front() const { return ring[head]; }
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+};
+
 
 #endif // PROCESS_H